@@ -40,6 +40,35 @@ struct get_balance_response
    vector<antelope::token_balance> balances;
 };
 
+struct get_globals_response
+{
+   // This doesn't need to be optional, but without it the CDT creates a memory leak
+   // See: https://github.com/AntelopeIO/cdt/issues/339
+   optional<eosiosystem::eosio_global_state> global;
+
+   eosiosystem::eosio_global_state2 global2;
+   eosiosystem::eosio_global_state3 global3;
+   eosiosystem::eosio_global_state4 global4;
+};
+
+struct get_balance_matrix_response
+{
+   vector<antelope::token_definition> tokens;   // column order of every row in amounts
+   vector<name>                       accounts; // accounts as requested
+   vector<uint8_t>                    rows;     // bitmap with a bit set for each account holding any of the tokens
+   vector<int64_t>                    amounts;  // one row of token amounts per account set in the bitmap
+};
+
+struct get_resources_response
+{
+   name                                     account;
+   int64_t                                  ram_quota = 0; // RAM limit in bytes as set by the system contract
+   eosiosystem::user_resources              resources;
+   vector<eosiosystem::delegated_bandwidth> delegations;
+   eosiosystem::gifted_ram                  giftedram;
+   vector<eosiosystem::powerup_order>       powerups;
+};
+
 struct get_network_response
 {
    // This doesn't need to be optional, but without it the CDT creates a memory leak
@@ -51,6 +80,83 @@ struct get_network_response
    eosiosystem::rex_pool       rex;
    antelope::token             token;
    int64_t                     ram_gift_bytes = eosiosystem::ram_gift_bytes;
+
+   optional<get_globals_response> globals; // only included when requested
+};
+
+struct token_distribution_request
+{
+   antelope::token_definition token;
+   vector<name>               locked; // additional holders whose balances are not considered circulating
+};
+
+struct get_powerup_cost_response
+{
+   int64_t  cpu_frac   = 0;
+   int64_t  net_frac   = 0;
+   int64_t  cpu_weight = 0;
+   int64_t  net_weight = 0;
+   asset    cpu_fee;
+   asset    net_fee;
+   asset    fee;
+   asset    min_powerup_fee;
+   uint32_t powerup_days  = 0;
+   bool     available     = true; // market has enough unused weight to fill the request
+   bool     meets_min_fee = true; // fee is above both zero and min_powerup_fee, as required by eosio::powerup
+};
+
+struct get_powerup_for_response
+{
+   asset                     max_payment;
+   get_powerup_cost_response cpu;
+   get_powerup_cost_response net;
+};
+
+struct get_name_bid_response
+{
+   name       newname;
+   name       high_bidder;
+   asset      high_bid;
+   time_point last_bid_time;
+   bool       closed = false; // auction closed and waiting to be claimed by the high bidder
+};
+
+struct get_name_bids_response
+{
+   vector<get_name_bid_response> bids;
+   optional<name>                next; // cursor to pass to the next call, empty when the listing is complete
+};
+
+struct get_rex_loans_response
+{
+   vector<eosiosystem::rex_loan> loans;
+   optional<uint64_t>            next; // loan_num to pass as the cursor of the next call, empty when complete
+};
+
+struct get_rex_orders_response
+{
+   vector<eosiosystem::rex_order> orders;
+   optional<name>                 next; // cursor to pass to the next call, empty when the listing is complete
+};
+
+struct get_producer_response
+{
+   name              owner;
+   double            total_votes = 0;
+   eosio::public_key producer_key;
+   bool              is_active = false;
+   string            url;
+   uint32_t          unpaid_blocks = 0;
+   time_point        last_claim_time;
+   uint16_t          location      = 0;
+   double            votepay_share = 0;
+   time_point        last_votepay_share_update;
+};
+
+struct get_producers_response
+{
+   vector<get_producer_response> producers;
+   optional<name>                next; // cursor to pass to the next call, empty when the listing is complete
 };
 
 class [[eosio::contract("api")]] api : public contract
@@ -58,6 +164,8 @@ class [[eosio::contract("api")]] api : public contract
 public:
    using contract::contract;
 
+   static constexpr uint32_t MAX_PAGE_LIMIT = 1000; // upper bound on rows returned by paginated actions
+
    struct [[eosio::table("config")]] config_row
    {
       name        system_contract       = antelope::default_system_contract;
@@ -95,6 +203,9 @@ public:
    [[eosio::action, eosio::read_only]] get_available_response available(const name account);
    using available_action = action_wrapper<"available"_n, &api::available>;
 
+   [[eosio::action, eosio::read_only]] vector<get_available_response> availables(const vector<name> accounts);
+   using availables_action = action_wrapper<"availables"_n, &api::availables>;
+
    [[eosio::action, eosio::read_only]] get_balance_response balance(const name                               account,
                                                                     const vector<antelope::token_definition> tokens,
                                                                     const bool zerobalances,
@@ -108,39 +219,96 @@ public:
             const bool                               systemtoken);
    using balances_action = action_wrapper<"balances"_n, &api::balances>;
 
+   [[eosio::action, eosio::read_only]] get_balance_matrix_response
+   balmatrix(const vector<name> accounts, const vector<antelope::token_definition> tokens);
+   using balmatrix_action = action_wrapper<"balmatrix"_n, &api::balmatrix>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::abi_hash contracthash(const name account);
    using contracthash_action = action_wrapper<"contracthash"_n, &api::contracthash>;
 
-   [[eosio::action, eosio::read_only]] get_network_response network();
+   [[eosio::action, eosio::read_only]] vector<eosiosystem::abi_hash> abihashes(const vector<name> accounts);
+   using abihashes_action = action_wrapper<"abihashes"_n, &api::abihashes>;
+
+   [[eosio::action, eosio::read_only]] get_network_response network(const binary_extension<bool> allglobals);
    using network_action = action_wrapper<"network"_n, &api::network>;
 
    [[eosio::action, eosio::read_only]] eosiosystem::powerup_state powerup();
    using powerup_action = action_wrapper<"powerup"_n, &api::powerup>;
 
+   [[eosio::action, eosio::read_only]] get_powerup_cost_response powerupcost(const int64_t cpu_frac,
+                                                                             const int64_t net_frac);
+   using powerupcost_action = action_wrapper<"powerupcost"_n, &api::powerupcost>;
+
+   [[eosio::action, eosio::read_only]] get_powerup_for_response powerupfor(const asset max_payment);
+   using powerupfor_action = action_wrapper<"powerupfor"_n, &api::powerupfor>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::rex_pool rex();
    using rex_action = action_wrapper<"rex"_n, &api::rex>;
 
    [[eosio::action, eosio::read_only]] eosiosystem::gifted_ram giftedram(const name account);
    using giftedram_action = action_wrapper<"giftedram"_n, &api::giftedram>;
 
+   [[eosio::action, eosio::read_only]] vector<eosiosystem::gifted_ram> giftedrams(const vector<name> accounts);
+   using giftedrams_action = action_wrapper<"giftedrams"_n, &api::giftedrams>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::eosio_global_state global();
    using global_action = action_wrapper<"global"_n, &api::global>;
 
+   [[eosio::action, eosio::read_only]] get_globals_response globals();
+   using globals_action = action_wrapper<"globals"_n, &api::globals>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::exchange_state ram();
    using ram_action = action_wrapper<"ram"_n, &api::ram>;
 
    [[eosio::action, eosio::read_only]] antelope::token distribution(const antelope::token_definition def);
    using distribution_action = action_wrapper<"distribution"_n, &api::distribution>;
 
+   [[eosio::action, eosio::read_only]] vector<antelope::token>
+   distribs(const vector<token_distribution_request> tokens);
+   using distribs_action = action_wrapper<"distribs"_n, &api::distribs>;
+
+   [[eosio::action, eosio::read_only]] get_name_bid_response namebid(const name newname);
+   using namebid_action = action_wrapper<"namebid"_n, &api::namebid>;
+
+   [[eosio::action, eosio::read_only]] get_name_bids_response namebids(const optional<name> cursor,
+                                                                       const uint32_t       limit);
+   using namebids_action = action_wrapper<"namebids"_n, &api::namebids>;
+
+   [[eosio::action, eosio::read_only]] eosiosystem::bid_refund bidrefund(const name bidder, const name newname);
+   using bidrefund_action = action_wrapper<"bidrefund"_n, &api::bidrefund>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::refund_request refund(const name account);
    using refund_action = action_wrapper<"refund"_n, &api::refund>;
 
    [[eosio::action, eosio::read_only]] vector<eosiosystem::delegated_bandwidth> delegations(const name account);
    using delegated_action = action_wrapper<"delegations"_n, &api::delegations>;
 
+   [[eosio::action, eosio::read_only]] get_producers_response producers(const optional<name> cursor,
+                                                                        const uint32_t       limit,
+                                                                        const bool           active_only);
+   using producers_action = action_wrapper<"producers"_n, &api::producers>;
+
    [[eosio::action, eosio::read_only]] vector<eosio::multisig::proposal> proposals(const name account);
    using proposals_action = action_wrapper<"proposals"_n, &api::proposals>;
 
+   [[eosio::action, eosio::read_only]] vector<get_resources_response> resources(const vector<name> accounts);
+   using resources_action = action_wrapper<"resources"_n, &api::resources>;
+
+   [[eosio::action, eosio::read_only]] get_rex_loans_response rexexpiring(const name               resource,
+                                                                          const optional<uint64_t> cursor,
+                                                                          const uint32_t           limit);
+   using rexexpiring_action = action_wrapper<"rexexpiring"_n, &api::rexexpiring>;
+
+   [[eosio::action, eosio::read_only]] get_rex_loans_response rexloans(const name               resource,
+                                                                       const name               owner,
+                                                                       const optional<uint64_t> cursor,
+                                                                       const uint32_t           limit);
+   using rexloans_action = action_wrapper<"rexloans"_n, &api::rexloans>;
+
+   [[eosio::action, eosio::read_only]] get_rex_orders_response rexqueue(const optional<name> cursor,
+                                                                        const uint32_t       limit);
+   using rexqueue_action = action_wrapper<"rexqueue"_n, &api::rexqueue>;
+
    [[eosio::action, eosio::read_only]] eosiosystem::rex_balance rexbal(const name account);
    using rexbal_action = action_wrapper<"rexbal"_n, &api::rexbal>;
 
@@ -157,18 +325,37 @@ public:
 
 private:
    config_row                               get_config();
-   antelope::token_distribution             get_token_distribution(const antelope::token_definition def);
+   void                                     check_page_limit(const uint32_t limit);
+   antelope::token_distribution             get_token_distribution(const config_row                 config,
+                                                                   const eosiosystem::rex_pool      rex_pool,
+                                                                   const antelope::token_definition def,
+                                                                   const vector<name>               locked);
    eosiosystem::gifted_ram                  get_gifted_ram(const api::config_row config, const name account);
    eosiosystem::eosio_global_state          get_global(const config_row config);
+   get_globals_response                     get_globals(const config_row config);
    eosiosystem::exchange_state              get_rammarket(const config_row config);
    eosiosystem::rex_pool                    get_rex_pool(const config_row config);
    eosiosystem::powerup_state               get_powerup(const config_row config);
+   eosiosystem::powerup_state               get_powerup_market(const config_row config);
+   get_powerup_cost_response                get_powerup_cost(const config_row                  config,
+                                                             const eosiosystem::powerup_state& state,
+                                                             const int64_t                     cpu_frac,
+                                                             const int64_t                     net_frac);
+   get_resources_response                   get_resources(const config_row                  config,
+                                                          eosiosystem::gifted_ram_table&    gr_table,
+                                                          eosiosystem::powerup_order_table& orders_table,
+                                                          const name                        account);
    eosiosystem::refund_request              get_refund_request(const config_row config, const name account);
    eosiosystem::rex_balance                 get_rex_balance(const config_row config, const name account);
    eosiosystem::rex_fund                    get_rex_fund(const config_row config, const name account);
+   eosiosystem::rex_loan                    get_rex_loan(const config_row config, const eosiosystem::rex_loan& loan);
+   eosiosystem::rex_order                   get_rex_order(const config_row config, const eosiosystem::rex_order& order);
    eosiosystem::voter_info                  get_voter_info(const config_row config, const name account);
    vector<eosiosystem::delegated_bandwidth> get_delegated_bandwidth(const config_row config, const name account);
    vector<eosio::multisig::proposal>        get_msig_proposals(const config_row config, const name account);
+   get_name_bid_response                    get_name_bid(const config_row config, const eosiosystem::name_bid& bid);
+   get_producer_response                    get_producer(const eosiosystem::producer_info& producer,
+                                                         eosiosystem::producers_table2&    producers2);
    antelope::token                          get_system_token(const config_row config, const bool distribution);
    antelope::token_definition               get_system_token_definition(const config_row config);
    antelope::token_balance                  get_system_token_balance(const config_row config, const name account);
@@ -177,6 +364,15 @@ private:
                                                          const vector<antelope::token_definition> tokens,
                                                          const bool                               zerobalances);
 
+   template <typename T>
+   get_rex_loans_response get_rex_loans_by_owner(const config_row         config,
+                                                 const name               owner,
+                                                 const optional<uint64_t> cursor,
+                                                 const uint32_t           limit);
+   template <typename T>
+   get_rex_loans_response
+   get_rex_loans_by_expiration(const config_row config, const optional<uint64_t> cursor, const uint32_t limit);
+
 #ifdef DEBUG
    template <typename T>
    void clear_table(T& table, uint64_t rows_to_clear);
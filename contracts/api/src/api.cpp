@@ -1,5 +1,7 @@
 #include "api/api.hpp"
 
+#include <algorithm>
+
 namespace vaultacontracts {
 
 api::config_row api::get_config()
@@ -8,11 +10,24 @@ api::config_row api::get_config()
    return _config.get_or_default();
 }
 
+// Batched lookups walk accounts in key order without duplicates, so consecutive finds hit neighbouring rows
+static vector<name> sorted_accounts(vector<name> accounts)
+{
+   sort(accounts.begin(), accounts.end());
+   accounts.erase(unique(accounts.begin(), accounts.end()), accounts.end());
+   return accounts;
+}
+
+void api::check_page_limit(const uint32_t limit)
+{
+   check(limit > 0 && limit <= MAX_PAGE_LIMIT, "limit must be between 1 and 1000");
+}
+
 antelope::token api::get_system_token(const config_row config, const bool distribution = false)
 {
    antelope::token system_token = {.id = get_system_token_definition(config)};
    if (distribution) {
-      system_token.distribution = get_token_distribution(system_token.id);
+      system_token.distribution = get_token_distribution(config, get_rex_pool(config), system_token.id, {});
    }
    return system_token;
 }
@@ -75,15 +90,22 @@ vector<eosiosystem::delegated_bandwidth> api::get_delegated_bandwidth(const api:
    return get_delegated_bandwidth(get_config(), account);
 }
 
+static eosiosystem::gifted_ram find_gifted_ram(eosiosystem::gifted_ram_table& gr_table, const name account)
+{
+   eosiosystem::gifted_ram gr;
+   auto                    gr_itr = gr_table.find(account.value);
+   if (gr_itr != gr_table.end()) {
+      gr = *gr_itr;
+   }
+   return gr;
+}
+
 eosiosystem::gifted_ram api::get_gifted_ram(const api::config_row config, const name account)
 {
    eosiosystem::gifted_ram gr;
    if (config.gifted_ram_enabled) {
       eosiosystem::gifted_ram_table gr_table(config.system_contract, config.system_contract.value);
-      auto                          gr_itr = gr_table.find(account.value);
-      if (gr_itr != gr_table.end()) {
-         gr = *gr_itr;
-      }
+      gr = find_gifted_ram(gr_table, account);
    }
    return gr;
 }
@@ -93,6 +115,24 @@ eosiosystem::gifted_ram api::get_gifted_ram(const api::config_row config, const
    return get_gifted_ram(get_config(), account);
 }
 
+[[eosio::action, eosio::read_only]] vector<eosiosystem::gifted_ram> api::giftedrams(const vector<name> accounts)
+{
+   auto                            config = get_config();
+   vector<eosiosystem::gifted_ram> responses;
+   responses.reserve(accounts.size());
+
+   eosiosystem::gifted_ram_table gr_table(config.system_contract, config.system_contract.value);
+   for (const auto& account : sorted_accounts(accounts)) {
+      eosiosystem::gifted_ram gr;
+      if (config.gifted_ram_enabled) {
+         gr = find_gifted_ram(gr_table, account);
+      }
+      gr.giftee = account;
+      responses.push_back(gr);
+   }
+   return responses;
+}
+
 vector<eosio::multisig::proposal> api::get_msig_proposals(const api::config_row config, const name account)
 {
    vector<eosio::multisig::proposal> msig_rows;
@@ -166,18 +206,24 @@ eosiosystem::voter_info api::get_voter_info(const api::config_row config, const
    return get_voter_info(get_config(), account);
 }
 
-eosiosystem::abi_hash get_contract_hash(const api::config_row config, const name account)
+typedef eosio::multi_index<"abihash"_n, eosiosystem::abi_hash> abi_hash_table;
+
+static eosiosystem::abi_hash find_contract_hash(abi_hash_table& abihash_table, const name account)
 {
-   eosiosystem::abi_hash                                  result;
-   eosio::multi_index<"abihash"_n, eosiosystem::abi_hash> abihash_table(config.system_contract,
-                                                                        config.system_contract.value);
-   auto                                                   abihash_itr = abihash_table.find(account.value);
+   eosiosystem::abi_hash result;
+   auto                  abihash_itr = abihash_table.find(account.value);
    if (abihash_itr != abihash_table.end() && abihash_itr->owner == account) {
       result = *abihash_itr;
    }
    return result;
 }
 
+eosiosystem::abi_hash get_contract_hash(const api::config_row config, const name account)
+{
+   abi_hash_table abihash_table(config.system_contract, config.system_contract.value);
+   return find_contract_hash(abihash_table, account);
+}
+
 [[eosio::action, eosio::read_only]] get_account_response api::account(
    const name account, const optional<vector<antelope::token_definition>> tokens, const optional<bool> zerobalances)
 {
@@ -231,6 +277,16 @@ api::accounts(const vector<name>                                 accounts,
    return get_available_response{.account = account, .available = !is_account(account)};
 }
 
+[[eosio::action, eosio::read_only]] vector<get_available_response> api::availables(const vector<name> accounts)
+{
+   vector<get_available_response> responses;
+   responses.reserve(accounts.size());
+   for (const auto& account : sorted_accounts(accounts)) {
+      responses.push_back(get_available_response{.account = account, .available = !is_account(account)});
+   }
+   return responses;
+}
+
 eosiosystem::eosio_global_state api::get_global(const api::config_row config)
 {
    eosiosystem::global_state_singleton global_table(config.system_contract, config.system_contract.value);
@@ -240,6 +296,21 @@ eosiosystem::eosio_global_state api::get_global(const api::config_row config)
 
 [[eosio::action, eosio::read_only]] eosiosystem::eosio_global_state api::global() { return get_global(get_config()); }
 
+get_globals_response api::get_globals(const api::config_row config)
+{
+   eosiosystem::global_state2_singleton global2_table(config.system_contract, config.system_contract.value);
+   eosiosystem::global_state3_singleton global3_table(config.system_contract, config.system_contract.value);
+   eosiosystem::global_state4_singleton global4_table(config.system_contract, config.system_contract.value);
+   return get_globals_response{
+      .global  = get_global(config),
+      .global2 = global2_table.get_or_default(),
+      .global3 = global3_table.get_or_default(),
+      .global4 = global4_table.get_or_default(),
+   };
+}
+
+[[eosio::action, eosio::read_only]] get_globals_response api::globals() { return get_globals(get_config()); }
+
 eosiosystem::exchange_state api::get_rammarket(const api::config_row config)
 {
    eosiosystem::exchange_state ram;
@@ -289,27 +360,30 @@ eosiosystem::powerup_state api::get_powerup(const api::config_row config)
 
 [[eosio::action, eosio::read_only]] eosiosystem::powerup_state api::powerup() { return get_powerup(get_config()); }
 
-[[eosio::action, eosio::read_only]] get_network_response api::network()
+[[eosio::action, eosio::read_only]] get_network_response api::network(const binary_extension<bool> allglobals)
 {
    auto config = get_config();
 
-   antelope::token_definition def = {
-      .contract = config.system_token_contract,
-      .symbol   = config.system_token_symbol,
-   };
-
-   return get_network_response{.global  = get_global(config),
-                               .ram     = get_rammarket(config),
-                               .rex     = get_rex_pool(config),
-                               .powerup = get_powerup(config),
-                               .token   = get_system_token(config, true)};
+   get_network_response response = {.powerup = get_powerup(config),
+                                    .ram     = get_rammarket(config),
+                                    .rex     = get_rex_pool(config),
+                                    .token   = get_system_token(config, true)};
+
+   // Reuse the global state loaded with the other singletons when they are requested
+   if (allglobals.has_value() && allglobals.value()) {
+      response.globals = get_globals(config);
+      response.global  = response.globals->global;
+   } else {
+      response.global = get_global(config);
+   }
+   return response;
 }
 
-antelope::token_distribution api::get_token_distribution(const antelope::token_definition def)
+antelope::token_distribution api::get_token_distribution(const config_row                 config,
+                                                         const eosiosystem::rex_pool      rex_pool,
+                                                         const antelope::token_definition def,
+                                                         const vector<name>               locked)
 {
-   auto config   = get_config();
-   auto rex_pool = get_rex_pool(config);
-
    antelope::token_distribution distribution = {
       .circulating = asset(0, def.symbol),
       .locked      = asset(0, def.symbol),
@@ -326,21 +400,30 @@ antelope::token_distribution api::get_token_distribution(const antelope::token_d
       distribution.circulating = distribution.supply;
    }
 
+   auto lock_balance = [&](const name holder) {
+      eosio::token::accounts holder_balances(def.contract, holder.value);
+      auto                   holder_balance_itr = holder_balances.find(def.symbol.code().raw());
+      if (holder_balance_itr != holder_balances.end()) {
+         distribution.locked += holder_balance_itr->balance;
+         distribution.circulating -= holder_balance_itr->balance;
+      }
+   };
+
    // Consider tokens in the system contract as locked
-   eosio::token::accounts system_balances(def.contract, config.system_contract.value);
-   auto                   system_balance_itr = system_balances.find(def.symbol.code().raw());
-   if (system_balance_itr != system_balances.end()) {
-      distribution.locked += system_balance_itr->balance;
-      distribution.circulating -= system_balance_itr->balance;
-   }
+   lock_balance(config.system_contract);
 
    // Consider tokens in the token contract as locked
    if (config.system_contract.value != config.system_token_contract.value) {
-      eosio::token::accounts contract_balances(def.contract, config.system_token_contract.value);
-      auto                   contract_balance_itr = contract_balances.find(def.symbol.code().raw());
-      if (contract_balance_itr != contract_balances.end()) {
-         distribution.locked += contract_balance_itr->balance;
-         distribution.circulating -= contract_balance_itr->balance;
+      lock_balance(config.system_token_contract);
+   }
+
+   // Consider tokens held by any additional accounts as locked, counting each holder once
+   vector<name> holders = locked;
+   sort(holders.begin(), holders.end());
+   holders.erase(unique(holders.begin(), holders.end()), holders.end());
+   for (const auto& holder : holders) {
+      if (holder != config.system_contract && holder != config.system_token_contract) {
+         lock_balance(holder);
       }
    }
 
@@ -349,7 +432,26 @@ antelope::token_distribution api::get_token_distribution(const antelope::token_d
 
 [[eosio::action, eosio::read_only]] antelope::token api::distribution(const antelope::token_definition definition)
 {
-   return {.id = definition, .distribution = get_token_distribution(definition)};
+   auto config = get_config();
+   return {.id = definition, .distribution = get_token_distribution(config, get_rex_pool(config), definition, {})};
+}
+
+[[eosio::action, eosio::read_only]] vector<antelope::token>
+api::distribs(const vector<token_distribution_request> tokens)
+{
+   // Shared state is loaded once for every token in the request
+   auto config   = get_config();
+   auto rex_pool = get_rex_pool(config);
+
+   vector<antelope::token> response;
+   response.reserve(tokens.size());
+   for (const auto& requested : tokens) {
+      response.push_back({
+         .id           = requested.token,
+         .distribution = get_token_distribution(config, rex_pool, requested.token, requested.locked),
+      });
+   }
+   return response;
 }
 
 vector<antelope::token_balance> api::get_balances(const config_row                         config,
@@ -424,12 +526,68 @@ api::balances(const vector<name>                 accounts,
    return response;
 }
 
+[[eosio::action, eosio::read_only]] get_balance_matrix_response
+api::balmatrix(const vector<name> accounts, const vector<antelope::token_definition> tokens)
+{
+   auto config = get_config();
+
+   get_balance_matrix_response response = {
+      .accounts = accounts,
+      .rows     = vector<uint8_t>((accounts.size() + 7) / 8, 0),
+   };
+   response.tokens.reserve(tokens.size());
+   for (const auto& requested : tokens) {
+      response.tokens.push_back({
+         .chain    = config.chain_id,
+         .contract = requested.contract,
+         .symbol   = requested.symbol,
+      });
+   }
+
+   vector<int64_t> row(tokens.size(), 0);
+   for (size_t i = 0; i < accounts.size(); i++) {
+      bool found = false;
+      for (size_t j = 0; j < tokens.size(); j++) {
+         eosio::token::accounts _accounts(tokens[j].contract, accounts[i].value);
+         auto                   balance_itr = _accounts.find(tokens[j].symbol.code().raw());
+         if (balance_itr != _accounts.end()) {
+            row[j] = balance_itr->balance.amount;
+            found  = true;
+         } else {
+            row[j] = 0;
+         }
+      }
+      // Accounts without any balance rows are only marked in the bitmap
+      if (found) {
+         response.rows[i / 8] |= uint8_t(1 << (i % 8));
+         response.amounts.insert(response.amounts.end(), row.begin(), row.end());
+      }
+   }
+
+   return response;
+}
+
 [[eosio::action, eosio::read_only]] eosiosystem::abi_hash api::contracthash(const name account)
 {
    auto config = get_config();
    return get_contract_hash(config, account);
 }
 
+[[eosio::action, eosio::read_only]] vector<eosiosystem::abi_hash> api::abihashes(const vector<name> accounts)
+{
+   auto                          config = get_config();
+   vector<eosiosystem::abi_hash> responses;
+   responses.reserve(accounts.size());
+
+   abi_hash_table abihash_table(config.system_contract, config.system_contract.value);
+   for (const auto& account : sorted_accounts(accounts)) {
+      auto result  = find_contract_hash(abihash_table, account);
+      result.owner = account;
+      responses.push_back(result);
+   }
+   return responses;
+}
+
 [[eosio::action]] void api::setconfig(const checksum256 chain_id,
                                       const name        system_contract,
                                       const name        system_contract_msig,
@@ -457,6 +615,12 @@ api::balances(const vector<name>                 accounts,
 
 } // namespace vaultacontracts
 
+#include "namebids.cpp"
+#include "powerup.cpp"
+#include "producers.cpp"
+#include "resources.cpp"
+#include "rex.cpp"
+
 // DEBUG (used on testnet)
 #ifdef DEBUG
 #include "debug.cpp"
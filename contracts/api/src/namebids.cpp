@@ -0,0 +1,74 @@
+#include "api/api.hpp"
+
+#include <limits>
+
+namespace vaultacontracts {
+
+get_name_bid_response api::get_name_bid(const api::config_row config, const eosiosystem::name_bid& bid)
+{
+   // A negative high_bid marks a closed auction waiting to be claimed by the high bidder
+   return get_name_bid_response{
+      .newname       = bid.newname,
+      .high_bidder   = bid.high_bidder,
+      .high_bid      = asset(bid.high_bid < 0 ? -bid.high_bid : bid.high_bid, config.system_token_symbol),
+      .last_bid_time = bid.last_bid_time,
+      .closed        = bid.high_bid < 0,
+   };
+}
+
+[[eosio::action, eosio::read_only]] get_name_bid_response api::namebid(const name newname)
+{
+   auto                        config = get_config();
+   eosiosystem::name_bid_table bids_table(config.system_contract, config.system_contract.value);
+   auto                        bid_itr = bids_table.find(newname.value);
+   if (bid_itr == bids_table.end()) {
+      return get_name_bid_response{.newname = newname, .high_bid = asset(0, config.system_token_symbol)};
+   }
+   return get_name_bid(config, *bid_itr);
+}
+
+[[eosio::action, eosio::read_only]] get_name_bids_response api::namebids(const optional<name> cursor,
+                                                                         const uint32_t       limit)
+{
+   check_page_limit(limit);
+
+   auto                        config = get_config();
+   eosiosystem::name_bid_table bids_table(config.system_contract, config.system_contract.value);
+
+   // highbid sorts open auctions by descending bid, closed auctions sort ahead of them and are skipped the same way
+   // the system contract skips them when closing auctions
+   auto bids_idx = bids_table.get_index<"highbid"_n>();
+   auto bid_itr  = bids_idx.lower_bound(std::numeric_limits<uint64_t>::max() / 2);
+   if (cursor.has_value()) {
+      const auto& bid = bids_table.get(cursor->value, "cursor name bid not found");
+      bid_itr         = bids_idx.iterator_to(bid);
+   }
+
+   get_name_bids_response response;
+   while (bid_itr != bids_idx.end()) {
+      if (response.bids.size() == limit) {
+         response.next = bid_itr->newname;
+         break;
+      }
+      response.bids.push_back(get_name_bid(config, *bid_itr));
+      bid_itr++;
+   }
+   return response;
+}
+
+[[eosio::action, eosio::read_only]] eosiosystem::bid_refund api::bidrefund(const name bidder, const name newname)
+{
+   auto config = get_config();
+
+   eosiosystem::bid_refund refund = {.bidder = bidder, .amount = asset(0, config.system_token_symbol)};
+   // Refunds are scoped to the name that was bid on
+   eosiosystem::bid_refund_table refunds_table(config.system_contract, newname.value);
+   auto                          refund_itr = refunds_table.find(bidder.value);
+   if (refund_itr != refunds_table.end()) {
+      // Balances should use the system token regardless of what the table responds with
+      refund.amount = asset(refund_itr->amount.amount, config.system_token_symbol);
+   }
+   return refund;
+}
+
+} // namespace vaultacontracts
@@ -0,0 +1,207 @@
+#include "api/api.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vaultacontracts {
+
+// The eosio::powerup action only expires this many queued orders before pricing a new one
+static constexpr uint32_t powerup_queue_max_items = 2;
+
+// The functions below mirror the powerup market math of the system contract (powerup.cpp) so that quotes match what
+// eosio::powerup would charge if it executed in the current block.
+
+static void powerup_update_weight(const time_point_sec                 now,
+                                  eosiosystem::powerup_state_resource& res,
+                                  int64_t&                             delta_available)
+{
+   if (now >= res.target_timestamp) {
+      res.weight_ratio = res.target_weight_ratio;
+   } else {
+      res.weight_ratio = res.initial_weight_ratio +
+                         int128_t(res.target_weight_ratio - res.initial_weight_ratio) *
+                            (now.utc_seconds - res.initial_timestamp.utc_seconds) /
+                            (res.target_timestamp.utc_seconds - res.initial_timestamp.utc_seconds);
+   }
+   int64_t new_weight =
+      res.assumed_stake_weight * int128_t(eosiosystem::powerup_frac) / res.weight_ratio - res.assumed_stake_weight;
+   delta_available += new_weight - res.weight;
+   res.weight = new_weight;
+}
+
+static void powerup_update_utilization(const time_point_sec now, eosiosystem::powerup_state_resource& res)
+{
+   if (now <= res.utilization_timestamp) {
+      return;
+   }
+   if (res.utilization >= res.adjusted_utilization) {
+      res.adjusted_utilization = res.utilization;
+   } else {
+      int64_t diff = res.adjusted_utilization - res.utilization;
+      int64_t delta =
+         diff * std::exp(-double(now.utc_seconds - res.utilization_timestamp.utc_seconds) / double(res.decay_secs));
+      delta                    = std::clamp<int64_t>(delta, 0, diff);
+      res.adjusted_utilization = res.utilization + delta;
+   }
+   res.utilization_timestamp = now;
+}
+
+static double powerup_price_function(const eosiosystem::powerup_state_resource& res, const double utilization)
+{
+   double price = res.min_price.amount;
+   // do not allow exponent < 1
+   double new_exponent = res.exponent - 1.0;
+   if (new_exponent <= 0.0) {
+      return res.max_price.amount;
+   }
+   price += (res.max_price.amount - res.min_price.amount) * std::pow(utilization / res.weight, new_exponent);
+   return price;
+}
+
+static double powerup_price_integral_delta(const eosiosystem::powerup_state_resource& res,
+                                           const double                               start_utilization,
+                                           const double                               end_utilization)
+{
+   double coefficient = (res.max_price.amount - res.min_price.amount) / res.exponent;
+   double start_u     = start_utilization / res.weight;
+   double end_u       = end_utilization / res.weight;
+   return res.min_price.amount * end_u - res.min_price.amount * start_u + coefficient * std::pow(end_u, res.exponent) -
+          coefficient * std::pow(start_u, res.exponent);
+}
+
+static int64_t powerup_calc_fee(const eosiosystem::powerup_state_resource& res, const int64_t utilization_increase)
+{
+   if (utilization_increase <= 0) {
+      return 0;
+   }
+
+   double  fee               = 0.0;
+   int64_t start_utilization = res.utilization;
+   int64_t end_utilization   = start_utilization + utilization_increase;
+
+   if (start_utilization < res.adjusted_utilization) {
+      fee += powerup_price_function(res, res.adjusted_utilization) *
+             std::min(utilization_increase, res.adjusted_utilization - start_utilization) / res.weight;
+      start_utilization = res.adjusted_utilization;
+   }
+
+   if (start_utilization < end_utilization) {
+      fee += powerup_price_integral_delta(res, start_utilization, end_utilization);
+   }
+
+   return std::ceil(fee);
+}
+
+eosiosystem::powerup_state api::get_powerup_market(const api::config_row config)
+{
+   auto state = get_powerup(config);
+   check(state.cpu.weight_ratio > 0 && state.net.weight_ratio > 0, "powerup hasn't been initialized");
+
+   const time_point_sec now                 = time_point_sec(current_time_point());
+   int64_t              net_delta_available = 0;
+   int64_t              cpu_delta_available = 0;
+
+   // Bring the market forward to the current block the same way eosio::powerup does before pricing an order
+   powerup_update_utilization(now, state.net);
+   powerup_update_utilization(now, state.cpu);
+
+   eosiosystem::powerup_order_table orders(config.system_contract, 0);
+   auto                             orders_idx = orders.get_index<"byexpires"_n>();
+   auto                             order_itr  = orders_idx.begin();
+   for (uint32_t i = 0; i < powerup_queue_max_items && order_itr != orders_idx.end() && order_itr->expires <= now;
+        i++, order_itr++) {
+      net_delta_available += order_itr->net_weight;
+      cpu_delta_available += order_itr->cpu_weight;
+   }
+
+   state.net.utilization -= net_delta_available;
+   state.cpu.utilization -= cpu_delta_available;
+   powerup_update_weight(now, state.net, net_delta_available);
+   powerup_update_weight(now, state.cpu, cpu_delta_available);
+
+   return state;
+}
+
+get_powerup_cost_response api::get_powerup_cost(const api::config_row             config,
+                                                const eosiosystem::powerup_state& state,
+                                                const int64_t                     cpu_frac,
+                                                const int64_t                     net_frac)
+{
+   get_powerup_cost_response response = {
+      .cpu_frac        = cpu_frac,
+      .net_frac        = net_frac,
+      .cpu_fee         = asset(0, config.system_token_symbol),
+      .net_fee         = asset(0, config.system_token_symbol),
+      .fee             = asset(0, config.system_token_symbol),
+      .min_powerup_fee = state.min_powerup_fee,
+      .powerup_days    = state.powerup_days,
+   };
+
+   auto process = [&](const int64_t frac, const eosiosystem::powerup_state_resource& res, int64_t& amount, asset& fee) {
+      if (!frac) {
+         return;
+      }
+      amount = int128_t(frac) * res.weight / eosiosystem::powerup_frac;
+      if (!res.weight || res.utilization + amount > res.weight) {
+         response.available = false;
+         return;
+      }
+      fee.amount = powerup_calc_fee(res, amount);
+      if (fee.amount <= 0) {
+         response.meets_min_fee = false;
+      }
+   };
+
+   process(net_frac, state.net, response.net_weight, response.net_fee);
+   process(cpu_frac, state.cpu, response.cpu_weight, response.cpu_fee);
+
+   response.fee = response.cpu_fee + response.net_fee;
+   if (response.fee < state.min_powerup_fee) {
+      response.meets_min_fee = false;
+   }
+
+   return response;
+}
+
+[[eosio::action, eosio::read_only]] get_powerup_cost_response api::powerupcost(const int64_t cpu_frac,
+                                                                               const int64_t net_frac)
+{
+   check(cpu_frac >= 0 && cpu_frac <= eosiosystem::powerup_frac, "cpu_frac must be between 0 and 10^15");
+   check(net_frac >= 0 && net_frac <= eosiosystem::powerup_frac, "net_frac must be between 0 and 10^15");
+
+   auto config = get_config();
+   return get_powerup_cost(config, get_powerup_market(config), cpu_frac, net_frac);
+}
+
+[[eosio::action, eosio::read_only]] get_powerup_for_response api::powerupfor(const asset max_payment)
+{
+   auto config = get_config();
+   check(max_payment.symbol == config.system_token_symbol, "max_payment must use the system token symbol");
+   check(max_payment.amount > 0, "max_payment must be positive");
+
+   const auto state = get_powerup_market(config);
+
+   // Fees only grow with the fraction requested, so the largest affordable fraction can be found by bisection
+   auto largest_affordable = [&](const bool cpu) {
+      int64_t low  = 0;
+      int64_t high = eosiosystem::powerup_frac;
+      while (low < high) {
+         const int64_t mid   = low + (high - low + 1) / 2;
+         const auto    quote = get_powerup_cost(config, state, cpu ? mid : 0, cpu ? 0 : mid);
+         if (quote.available && quote.fee <= max_payment) {
+            low = mid;
+         } else {
+            high = mid - 1;
+         }
+      }
+      return get_powerup_cost(config, state, cpu ? low : 0, cpu ? 0 : low);
+   };
+
+   return get_powerup_for_response{
+      .max_payment = max_payment,
+      .cpu         = largest_affordable(true),
+      .net         = largest_affordable(false),
+   };
+}
+
+} // namespace vaultacontracts
@@ -0,0 +1,56 @@
+#include "api/api.hpp"
+
+namespace vaultacontracts {
+
+get_producer_response api::get_producer(const eosiosystem::producer_info& producer,
+                                        eosiosystem::producers_table2&    producers2)
+{
+   get_producer_response response = {
+      .owner           = producer.owner,
+      .total_votes     = producer.total_votes,
+      .producer_key    = producer.producer_key,
+      .is_active       = producer.is_active,
+      .url             = producer.url,
+      .unpaid_blocks   = producer.unpaid_blocks,
+      .last_claim_time = producer.last_claim_time,
+      .location        = producer.location,
+   };
+
+   auto producer2_itr = producers2.find(producer.owner.value);
+   if (producer2_itr != producers2.end()) {
+      response.votepay_share             = producer2_itr->votepay_share;
+      response.last_votepay_share_update = producer2_itr->last_votepay_share_update;
+   }
+   return response;
+}
+
+[[eosio::action, eosio::read_only]] get_producers_response
+api::producers(const optional<name> cursor, const uint32_t limit, const bool active_only)
+{
+   check_page_limit(limit);
+
+   auto                          config = get_config();
+   eosiosystem::producers_table  producers_table(config.system_contract, config.system_contract.value);
+   eosiosystem::producers_table2 producers2_table(config.system_contract, config.system_contract.value);
+
+   // prototalvote sorts active producers by descending votes, followed by inactive producers
+   auto producers_idx = producers_table.get_index<"prototalvote"_n>();
+   auto producer_itr  = producers_idx.begin();
+   if (cursor.has_value()) {
+      const auto& producer = producers_table.get(cursor->value, "cursor producer not found");
+      producer_itr         = producers_idx.iterator_to(producer);
+   }
+
+   get_producers_response response;
+   while (producer_itr != producers_idx.end() && (!active_only || producer_itr->is_active)) {
+      if (response.producers.size() == limit) {
+         response.next = producer_itr->owner;
+         break;
+      }
+      response.producers.push_back(get_producer(*producer_itr, producers2_table));
+      producer_itr++;
+   }
+   return response;
+}
+
+} // namespace vaultacontracts
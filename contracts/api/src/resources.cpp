@@ -0,0 +1,56 @@
+#include "api/api.hpp"
+
+namespace vaultacontracts {
+
+get_resources_response api::get_resources(const api::config_row             config,
+                                          eosiosystem::gifted_ram_table&    gr_table,
+                                          eosiosystem::powerup_order_table& orders_table,
+                                          const name                        account)
+{
+   get_resources_response response = {
+      .account     = account,
+      .resources   = {.owner      = account,
+                      .net_weight = asset(0, config.system_token_symbol),
+                      .cpu_weight = asset(0, config.system_token_symbol)},
+      .delegations = get_delegated_bandwidth(config, account),
+   };
+
+   eosiosystem::user_resources_table userres_table(config.system_contract, account.value);
+   auto                              userres_itr = userres_table.find(account.value);
+   if (userres_itr != userres_table.end()) {
+      // Balances should use the system token regardless of what the table responds with
+      response.resources.net_weight = asset(userres_itr->net_weight.amount, config.system_token_symbol);
+      response.resources.cpu_weight = asset(userres_itr->cpu_weight.amount, config.system_token_symbol);
+      response.resources.ram_bytes  = userres_itr->ram_bytes;
+   }
+   // The system contract sets the RAM limit to the purchased and gifted bytes plus the bytes given at creation
+   response.ram_quota = response.resources.ram_bytes + eosiosystem::ram_gift_bytes;
+
+   if (config.gifted_ram_enabled) {
+      response.giftedram = find_gifted_ram(gr_table, account);
+   }
+
+   auto orders_idx = orders_table.get_index<"byowner"_n>();
+   auto order_itr  = orders_idx.lower_bound(account.value);
+   while (order_itr != orders_idx.end() && order_itr->owner == account) {
+      response.powerups.push_back(*order_itr);
+      order_itr++;
+   }
+   return response;
+}
+
+[[eosio::action, eosio::read_only]] vector<get_resources_response> api::resources(const vector<name> accounts)
+{
+   auto                           config = get_config();
+   vector<get_resources_response> responses;
+   responses.reserve(accounts.size());
+
+   eosiosystem::gifted_ram_table    gr_table(config.system_contract, config.system_contract.value);
+   eosiosystem::powerup_order_table orders_table(config.system_contract, 0);
+   for (const auto& account : sorted_accounts(accounts)) {
+      responses.push_back(get_resources(config, gr_table, orders_table, account));
+   }
+   return responses;
+}
+
+} // namespace vaultacontracts
@@ -0,0 +1,143 @@
+#include "api/api.hpp"
+
+namespace vaultacontracts {
+
+eosiosystem::rex_loan api::get_rex_loan(const api::config_row config, const eosiosystem::rex_loan& loan)
+{
+   eosiosystem::rex_loan result = loan;
+   // Balances should use the system token regardless of what the table responds with
+   result.payment      = asset(loan.payment.amount, config.system_token_symbol);
+   result.balance      = asset(loan.balance.amount, config.system_token_symbol);
+   result.total_staked = asset(loan.total_staked.amount, config.system_token_symbol);
+   return result;
+}
+
+eosiosystem::rex_order api::get_rex_order(const api::config_row config, const eosiosystem::rex_order& order)
+{
+   eosiosystem::rex_order result = order;
+   // Balances should use the system token regardless of what the table responds with
+   result.rex_requested = asset(order.rex_requested.amount, config.system_rex_symbol);
+   result.proceeds      = asset(order.proceeds.amount, config.system_token_symbol);
+   result.stake_change  = asset(order.stake_change.amount, config.system_token_symbol);
+   return result;
+}
+
+template <typename T>
+get_rex_loans_response api::get_rex_loans_by_owner(const api::config_row    config,
+                                                   const name               owner,
+                                                   const optional<uint64_t> cursor,
+                                                   const uint32_t           limit)
+{
+   get_rex_loans_response response;
+   if (!eosiosystem::system_contract::rex_system_initialized(config.system_contract)) {
+      return response;
+   }
+
+   T    loans_table(config.system_contract, config.system_contract.value);
+   auto loans_idx = loans_table.template get_index<"byowner"_n>();
+   auto loan_itr  = loans_idx.lower_bound(owner.value);
+   if (cursor.has_value()) {
+      const auto& loan = loans_table.get(cursor.value(), "cursor loan not found");
+      check(loan.from == owner, "cursor loan does not belong to owner");
+      loan_itr = loans_idx.iterator_to(loan);
+   }
+
+   while (loan_itr != loans_idx.end() && loan_itr->from == owner) {
+      if (response.loans.size() == limit) {
+         response.next = loan_itr->loan_num;
+         break;
+      }
+      response.loans.push_back(get_rex_loan(config, *loan_itr));
+      loan_itr++;
+   }
+   return response;
+}
+
+template <typename T>
+get_rex_loans_response
+api::get_rex_loans_by_expiration(const api::config_row config, const optional<uint64_t> cursor, const uint32_t limit)
+{
+   get_rex_loans_response response;
+   if (!eosiosystem::system_contract::rex_system_initialized(config.system_contract)) {
+      return response;
+   }
+
+   T    loans_table(config.system_contract, config.system_contract.value);
+   auto loans_idx = loans_table.template get_index<"byexpr"_n>();
+   auto loan_itr  = loans_idx.begin();
+   if (cursor.has_value()) {
+      const auto& loan = loans_table.get(cursor.value(), "cursor loan not found");
+      loan_itr         = loans_idx.iterator_to(loan);
+   }
+
+   while (loan_itr != loans_idx.end()) {
+      if (response.loans.size() == limit) {
+         response.next = loan_itr->loan_num;
+         break;
+      }
+      response.loans.push_back(get_rex_loan(config, *loan_itr));
+      loan_itr++;
+   }
+   return response;
+}
+
+[[eosio::action, eosio::read_only]] get_rex_loans_response api::rexloans(const name               resource,
+                                                                         const name               owner,
+                                                                         const optional<uint64_t> cursor,
+                                                                         const uint32_t           limit)
+{
+   check_page_limit(limit);
+   check(resource == "cpu"_n || resource == "net"_n, "resource must be either cpu or net");
+
+   auto config = get_config();
+   if (resource == "cpu"_n) {
+      return get_rex_loans_by_owner<eosiosystem::rex_cpu_loan_table>(config, owner, cursor, limit);
+   }
+   return get_rex_loans_by_owner<eosiosystem::rex_net_loan_table>(config, owner, cursor, limit);
+}
+
+[[eosio::action, eosio::read_only]] get_rex_loans_response
+api::rexexpiring(const name resource, const optional<uint64_t> cursor, const uint32_t limit)
+{
+   check_page_limit(limit);
+   check(resource == "cpu"_n || resource == "net"_n, "resource must be either cpu or net");
+
+   auto config = get_config();
+   if (resource == "cpu"_n) {
+      return get_rex_loans_by_expiration<eosiosystem::rex_cpu_loan_table>(config, cursor, limit);
+   }
+   return get_rex_loans_by_expiration<eosiosystem::rex_net_loan_table>(config, cursor, limit);
+}
+
+[[eosio::action, eosio::read_only]] get_rex_orders_response api::rexqueue(const optional<name> cursor,
+                                                                          const uint32_t       limit)
+{
+   check_page_limit(limit);
+
+   get_rex_orders_response response;
+   auto                    config = get_config();
+   if (!eosiosystem::system_contract::rex_system_initialized(config.system_contract)) {
+      return response;
+   }
+
+   // bytime sorts open orders by the time they were queued, closed orders sort last
+   eosiosystem::rex_order_table orders_table(config.system_contract, config.system_contract.value);
+   auto                         orders_idx = orders_table.get_index<"bytime"_n>();
+   auto                         order_itr  = orders_idx.begin();
+   if (cursor.has_value()) {
+      const auto& order = orders_table.get(cursor->value, "cursor order not found");
+      order_itr         = orders_idx.iterator_to(order);
+   }
+
+   while (order_itr != orders_idx.end() && order_itr->is_open) {
+      if (response.orders.size() == limit) {
+         response.next = order_itr->owner;
+         break;
+      }
+      response.orders.push_back(get_rex_order(config, *order_itr));
+      order_itr++;
+   }
+   return response;
+}
+
+} // namespace vaultacontracts
@@ -13,6 +13,22 @@ using namespace std;
 
 namespace vaultacontracts {
 
+struct estimate_response
+{
+   int64_t bytes; // RAM bytes bought for each account
+   asset   cost;  // cost of the next account at the current market price
+   asset   total; // cost of count accounts, each bought after the previous ones
+};
+
+#ifdef DEBUG
+struct ram_math_check
+{
+   uint32_t checked        = 0;
+   uint32_t mismatched     = 0;
+   int64_t  max_difference = 0;
+};
+#endif
+
 class [[eosio::contract("create")]] create : public contract
 {
 public:
@@ -22,21 +38,84 @@ public:
    static const int64_t BYTES_FOR_TOKEN_BALANCE    = 260;
    static const int64_t BYTES_FOR_CREATION         = BYTES_FOR_ACCOUNT_CREATION + BYTES_FOR_TOKEN_BALANCE;
 
+   // Billable sizes nodeos charges per authority entry when storing a permission
+   static const int64_t BILLABLE_KEY_WEIGHT_BYTES     = 8;
+   static const int64_t BILLABLE_PACKED_KEY_BYTES     = 34; // K1 and R1 keys, WA keys are larger
+   static const int64_t BILLABLE_ACCOUNT_WEIGHT_BYTES = 24;
+   static const int64_t BILLABLE_WAIT_WEIGHT_BYTES    = 16;
+
+   // Maximum number of comma separated accounts a single transfer memo may create
+   static const uint32_t MAX_BATCH_CREATIONS = 25;
+
+   // Maximum number of accounts a single estimate may price
+   static const uint32_t MAX_ESTIMATE_COUNT = 1000;
+
+   // Number of recent creations kept in the receipts table before the oldest slot is overwritten
+   static const uint64_t CREATION_RECEIPT_SLOTS = 256;
+
    static constexpr name   SYSTEM_CONTRACT        = "eosio"_n;
    static constexpr name   SYSTEM_CONTRACT_PROXY  = "core.vaulta"_n;
    static constexpr symbol PAYMENT_TOKEN          = symbol("A", 4);
    static constexpr name   PAYMENT_TOKEN_CONTRACT = "core.vaulta"_n;
    static constexpr symbol SYSTEM_RAM             = symbol("RAMCORE", 4);
 
+   struct [[eosio::table("config")]] config_row
+   {
+      bool     receipt_table = false; // record creations in the receipts table instead of sending logcreation
+      uint64_t next_receipt  = 0;
+   };
+   typedef eosio::singleton<"config"_n, config_row> config_table;
+
+   struct [[eosio::table("receipts")]] receipt_row
+   {
+      uint64_t slot;
+      uint64_t sequence;
+      name     account;
+      name     from;
+      asset    excess;
+      asset    ram;
+      uint64_t timestamp;
+
+      uint64_t primary_key() const { return slot; }
+   };
+   typedef eosio::multi_index<"receipts"_n, receipt_row> receipts_table;
+
+   struct [[eosio::table("deposits")]] deposit_row
+   {
+      name  partner;
+      asset balance;
+
+      uint64_t primary_key() const { return partner.value; }
+   };
+   typedef eosio::multi_index<"deposits"_n, deposit_row> deposits_table;
+
+   [[eosio::action]] void createacct(name partner, name account, string key);
+   using createacct_action = eosio::action_wrapper<"createacct"_n, &create::createacct>;
+
+   [[eosio::action]] void
+   createauths(name partner, name account, eosiosystem::authority owner, eosiosystem::authority active);
+   using createauths_action = eosio::action_wrapper<"createauths"_n, &create::createauths>;
+
+   [[eosio::action]] void withdraw(name partner, asset quantity);
+   using withdraw_action = eosio::action_wrapper<"withdraw"_n, &create::withdraw>;
+
+   [[eosio::action]] void setreceipts(bool receipt_table);
+   using setreceipts_action = eosio::action_wrapper<"setreceipts"_n, &create::setreceipts>;
+
    [[eosio::on_notify("*::transfer")]] void ontransfer(name from, name to, asset quantity, string memo);
    using ontransfer_action = eosio::action_wrapper<"transfer"_n, &create::ontransfer>;
 
    [[eosio::action, eosio::read_only]] pair<name, eosiosystem::authority> parsememo(string memo);
    using parsememo_action = eosio::action_wrapper<"parsememo"_n, &create::parsememo>;
 
-   [[eosio::action, eosio::read_only]] asset estimatecost();
+   [[eosio::action, eosio::read_only]] asset estimatecost(const binary_extension<eosiosystem::authority> owner,
+                                                          const binary_extension<eosiosystem::authority> active);
    using estimatecost_action = eosio::action_wrapper<"estimatecost"_n, &create::estimatecost>;
 
+   [[eosio::action, eosio::read_only]] estimate_response
+   estimate(const uint32_t extra_bytes, const string key_format, const uint32_t count);
+   using estimate_action = eosio::action_wrapper<"estimate"_n, &create::estimate>;
+
    [[eosio::action]] void logcreation(name account, name from, asset excess, asset ram, uint64_t timestamp);
    using logcreation_action = eosio::action_wrapper<"logcreation"_n, &create::logcreation>;
 
@@ -48,7 +127,31 @@ public:
       eosiosystem::authority active;
    };
 
+#ifdef DEBUG
+   [[eosio::action, eosio::read_only]] ram_math_check
+   rammathcheck(const int64_t ram_reserve, const int64_t eos_reserve, const uint32_t count);
+#endif
+
 private:
+   void  add_deposit(name partner, asset quantity);
+   void  debit_deposit(name partner, asset cost);
+   asset minimum_deposit();
+
+   void check_authority(const eosiosystem::authority& auth);
+   void send_creation(name                          account,
+                      const eosiosystem::authority& owner,
+                      const eosiosystem::authority& active,
+                      asset                         ram);
+   void log_creation(name account, name from, asset ram);
+   void record_creation(config_row& config, name account, name from, asset excess, asset ram, uint64_t timestamp);
+
+   int64_t authority_bytes(const eosiosystem::authority& auth);
+   int64_t creation_bytes(const eosiosystem::authority& owner, const eosiosystem::authority& active);
+   int64_t largest_key_creation_bytes();
+
+   eosiosystem::authority                     parse_authority(string_view public_key_str);
+   pair<name, eosiosystem::authority>         parse_account(string_view entry);
+   vector<pair<name, eosiosystem::authority>> parse_accounts(string_view memo);
 };
 
 } // namespace vaultacontracts
\ No newline at end of file
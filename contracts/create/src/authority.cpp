@@ -0,0 +1,66 @@
+namespace vaultacontracts {
+
+// Mirrors authority::get_billable_size in nodeos, which is charged to the creator for each new permission
+int64_t create::authority_bytes(const eosiosystem::authority& auth)
+{
+   int64_t bytes = auth.accounts.size() * BILLABLE_ACCOUNT_WEIGHT_BYTES;
+   bytes        += auth.waits.size() * BILLABLE_WAIT_WEIGHT_BYTES;
+   for (const auto& k : auth.keys) {
+      bytes += BILLABLE_KEY_WEIGHT_BYTES + eosio::pack_size(k.key);
+   }
+   return bytes;
+}
+
+int64_t create::creation_bytes(const eosiosystem::authority& owner, const eosiosystem::authority& active)
+{
+   // BYTES_FOR_CREATION already covers a single K1 or R1 key in each of the two authorities
+   const int64_t single_key = BILLABLE_KEY_WEIGHT_BYTES + BILLABLE_PACKED_KEY_BYTES;
+   const int64_t extra      = authority_bytes(owner) + authority_bytes(active) - 2 * single_key;
+   return BYTES_FOR_CREATION + (extra > 0 ? extra : 0);
+}
+
+int64_t create::largest_key_creation_bytes()
+{
+   // The largest WebAuthn key the base58 decoder accepts, its rpid fills what the checksum and point leave
+   eosio::webauthn_public_key wa_key;
+   wa_key.rpid = string(antelope::BASE58_KEY_MAX_BYTES - 33 - 2 - 4, 'a');
+
+   const eosiosystem::key_weight k = {.key = eosio::public_key(std::in_place_index<2>, wa_key), .weight = 1};
+   const eosiosystem::authority  auth{.threshold = 1, .keys = {k}, .accounts = {}, .waits = {}};
+   return creation_bytes(auth, auth);
+}
+
+void create::check_authority(const eosiosystem::authority& auth)
+{
+   check(auth.threshold > 0, "Authority threshold must be positive");
+
+   uint64_t weights = 0;
+   for (const auto& k : auth.keys) {
+      weights += k.weight;
+   }
+   for (const auto& a : auth.accounts) {
+      weights += a.weight;
+   }
+   for (const auto& w : auth.waits) {
+      weights += w.weight;
+   }
+   check(weights >= auth.threshold, "Authority threshold cannot be met");
+}
+
+[[eosio::action]] void
+create::createauths(name partner, name account, eosiosystem::authority owner, eosiosystem::authority active)
+{
+   require_auth(partner);
+   check(!is_account(account), "Account already exists");
+   check_authority(owner);
+   check_authority(active);
+
+   const antelope::ram_market market(PAYMENT_TOKEN, SYSTEM_CONTRACT);
+   const asset                cost = market.cost_with_fee(creation_bytes(owner, active));
+   debit_deposit(partner, cost);
+
+   send_creation(account, owner, active, cost);
+   log_creation(account, partner, cost);
+}
+
+} // namespace vaultacontracts
@@ -1,5 +1,11 @@
 #include <create/create.hpp>
 
+#include "authority.cpp"
+#include "deposit.cpp"
 #include "transfer.cpp"
 #include <antelope/publickey.cpp>
 #include <antelope/ram.cpp>
+
+#ifdef DEBUG
+#include "debug.cpp"
+#endif
@@ -0,0 +1,35 @@
+namespace vaultacontracts {
+
+static void compare_ram_math(ram_math_check& result, const int64_t expected, const int64_t actual)
+{
+   const int64_t difference = actual > expected ? actual - expected : expected - actual;
+   result.checked++;
+   if (difference != 0) {
+      result.mismatched++;
+      result.max_difference = std::max(result.max_difference, difference);
+   }
+}
+
+// Compares the fixed point RAM math against the double version for every amount from 1 to count
+[[eosio::action, eosio::read_only]] ram_math_check
+create::rammathcheck(const int64_t ram_reserve, const int64_t eos_reserve, const uint32_t count)
+{
+   check(ram_reserve > 0 && eos_reserve > 0, "reserves must be positive");
+   check(count < ram_reserve, "count must be less than the RAM reserve");
+
+   ram_math_check result;
+   for (int64_t amount = 1; amount <= count; amount++) {
+      // cost of buying amount bytes
+      compare_ram_math(result, antelope::get_bancor_input(ram_reserve, eos_reserve, amount),
+                       antelope::fixed::get_bancor_input(ram_reserve, eos_reserve, amount));
+      // bytes bought for amount tokens
+      compare_ram_math(result, antelope::get_bancor_output(eos_reserve, ram_reserve, amount),
+                       antelope::fixed::get_bancor_output(eos_reserve, ram_reserve, amount));
+      // proceeds of selling amount bytes
+      compare_ram_math(result, antelope::get_bancor_output(ram_reserve, eos_reserve, amount),
+                       antelope::fixed::get_bancor_output(ram_reserve, eos_reserve, amount));
+   }
+   return result;
+}
+
+} // namespace vaultacontracts
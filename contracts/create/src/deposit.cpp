@@ -0,0 +1,71 @@
+namespace vaultacontracts {
+
+void create::add_deposit(name partner, asset quantity)
+{
+   // Deposits are credited from a transfer notification, where the partner cannot be billed for the row, so a new row
+   // must be funded with at least one creation to keep small deposits from consuming the contract's RAM
+   deposits_table deposits(get_self(), get_self().value);
+   auto           itr = deposits.find(partner.value);
+   if (itr == deposits.end()) {
+      const asset minimum = minimum_deposit();
+      check(quantity >= minimum, "A first deposit of at least " + minimum.to_string() + " is required");
+      deposits.emplace(get_self(), [&](auto& row) {
+         row.partner = partner;
+         row.balance = quantity;
+      });
+   } else {
+      deposits.modify(itr, same_payer, [&](auto& row) { row.balance += quantity; });
+   }
+}
+
+asset create::minimum_deposit()
+{
+   return antelope::ram_market(PAYMENT_TOKEN, SYSTEM_CONTRACT).cost_with_fee(BYTES_FOR_CREATION);
+}
+
+void create::debit_deposit(name partner, asset cost)
+{
+   deposits_table deposits(get_self(), get_self().value);
+   auto           itr = deposits.require_find(partner.value, "No deposit found for partner");
+   check(itr->balance >= cost, "A deposit of " + cost.to_string() + " is required to pay for account creation costs");
+   deposits.modify(itr, same_payer, [&](auto& row) { row.balance -= cost; });
+}
+
+[[eosio::action]] void create::createacct(name partner, name account, string key)
+{
+   require_auth(partner);
+   check(!is_account(account), "Account already exists");
+   const auto auth = parse_authority(key);
+
+   const antelope::ram_market market(PAYMENT_TOKEN, SYSTEM_CONTRACT);
+   const asset                cost = market.cost_with_fee(creation_bytes(auth, auth));
+   debit_deposit(partner, cost);
+
+   send_creation(account, auth, auth, cost);
+   log_creation(account, partner, cost);
+}
+
+[[eosio::action]] void create::withdraw(name partner, asset quantity)
+{
+   require_auth(partner);
+   check(quantity.symbol == PAYMENT_TOKEN, "Invalid symbol");
+   check(quantity.amount > 0, "Invalid amount");
+
+   deposits_table deposits(get_self(), get_self().value);
+   auto           itr = deposits.require_find(partner.value, "No deposit found for partner");
+   check(itr->balance >= quantity, "Insufficient deposit");
+   if (itr->balance == quantity) {
+      deposits.erase(itr);
+   } else {
+      // A partial withdrawal could otherwise leave a dust row behind for the contract to keep paying for
+      const asset minimum = minimum_deposit();
+      check(itr->balance - quantity >= minimum,
+            "Withdraw the full deposit or leave at least " + minimum.to_string() + " deposited");
+      deposits.modify(itr, same_payer, [&](auto& row) { row.balance -= quantity; });
+   }
+
+   token::transfer_action transfer{PAYMENT_TOKEN_CONTRACT, {get_self(), "active"_n}};
+   transfer.send(get_self(), partner, quantity, string("Deposit withdrawal"));
+}
+
+} // namespace vaultacontracts
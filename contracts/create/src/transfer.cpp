@@ -1,30 +1,63 @@
 namespace vaultacontracts {
 
-[[eosio::action, eosio::read_only]]
-pair<name, eosiosystem::authority> create::parsememo(string memo)
+pair<name, eosiosystem::authority> create::parse_account(string_view entry)
 {
-   size_t separator = memo.find("-");
+   size_t separator = entry.find("-");
    check(separator != string::npos, "Invalid memo format");
-   auto account_name_str = memo.substr(0, separator);
+   auto account_name_str = entry.substr(0, separator);
    // check that the account name is valid
    check(account_name_str.length() > 0, "Invalid account name");
    check(account_name_str.length() <= 12, "Account name is too long");
 
    auto account        = name(account_name_str);
-   auto public_key_str = memo.substr(separator + 1);
+   auto public_key_str = entry.substr(separator + 1);
 
    check(!is_account(account), "Account already exists");
 
+   return make_pair(account, parse_authority(public_key_str));
+}
+
+eosiosystem::authority create::parse_authority(string_view public_key_str)
+{
    eosio::public_key public_key;
    if (public_key_str.rfind("PUB_", 0) == 0) {
       public_key = antelope::stringToPublicKey(public_key_str);
+   } else if (antelope::isHexPublicKey(public_key_str)) {
+      public_key = antelope::hexToPublicKey(public_key_str);
    } else {
       public_key = antelope::stringToLegacyPublicKey(public_key_str);
    }
 
    eosiosystem::key_weight k = eosiosystem::key_weight{public_key, 1};
    eosiosystem::authority  auth{.threshold = 1, .keys = {k}, .accounts = {}, .waits = {}};
-   return make_pair(account, auth);
+   return auth;
+}
+
+[[eosio::action, eosio::read_only]]
+pair<name, eosiosystem::authority> create::parsememo(string memo)
+{
+   return parse_account(memo);
+}
+
+vector<pair<name, eosiosystem::authority>> create::parse_accounts(string_view memo)
+{
+   vector<pair<name, eosiosystem::authority>> accounts;
+   while (true) {
+      size_t separator = memo.find(",");
+      accounts.push_back(parse_account(memo.substr(0, separator)));
+      check(accounts.size() <= MAX_BATCH_CREATIONS, "Too many accounts in memo");
+      if (separator == string_view::npos) {
+         break;
+      }
+      memo.remove_prefix(separator + 1);
+   }
+
+   for (size_t i = 1; i < accounts.size(); i++) {
+      for (size_t j = 0; j < i; j++) {
+         check(accounts[i].first != accounts[j].first, "Duplicate account in memo");
+      }
+   }
+   return accounts;
 }
 
 [[eosio::on_notify("*::transfer")]]
@@ -56,30 +89,154 @@ void create::ontransfer(name from, name to, asset quantity, string memo)
    check(quantity.symbol == PAYMENT_TOKEN, "Invalid symbol");
    check(quantity.amount > 0, "Invalid amount");
 
-   auto [account, auth] = parsememo(memo);
-   const auto  cost     = antelope::ram_cost_with_fee(BYTES_FOR_CREATION, PAYMENT_TOKEN);
-   const asset excess   = quantity - cost;
+   if (memo == "deposit") {
+      add_deposit(from, quantity);
+      return;
+   }
 
-   check(quantity >= cost, "A minimum of " + cost.to_string() + " is required to pay for account creation costs");
+   const auto accounts = parse_accounts(memo);
+
+   // Every creation buys its RAM after the previous ones in the batch, so each is priced as the next sequential
+   // purchase against the same market snapshot
+   const antelope::ram_market market(PAYMENT_TOKEN, SYSTEM_CONTRACT);
+   vector<asset>              costs;
+   asset                      total_cost(0, PAYMENT_TOKEN);
+   uint64_t                   bought_bytes = 0;
+   for (const auto& [account, auth] : accounts) {
+      const int64_t bytes = creation_bytes(auth, auth);
+      costs.push_back(market.cost_with_fee(bytes, bought_bytes));
+      total_cost   += costs.back();
+      bought_bytes += bytes;
+   }
+   const asset excess = quantity - total_cost;
 
-   system_contract::newaccount_action newaccount{SYSTEM_CONTRACT, {get_self(), "active"_n}};
-   newaccount.send(get_self(), account, auth, auth);
+   check(quantity >= total_cost,
+         "A minimum of " + total_cost.to_string() + " is required to pay for account creation costs");
 
-   system_contract::buyram_action buyram{SYSTEM_CONTRACT_PROXY, {get_self(), "active"_n}};
-   buyram.send(get_self(), account, cost);
+   for (size_t i = 0; i < accounts.size(); i++) {
+      send_creation(accounts[i].first, accounts[i].second, accounts[i].second, costs[i]);
+   }
 
+   // A single creation refunds the excess to the new account as its starting balance, a batch refunds it to the payer
+   const bool batch = accounts.size() > 1;
    if (excess.amount > 0) {
       token::transfer_action transfer{PAYMENT_TOKEN_CONTRACT, {get_self(), "active"_n}};
-      transfer.send(get_self(), account, excess, string("Excess funds from account creation"));
+      transfer.send(get_self(), batch ? from : accounts[0].first, excess, string("Excess funds from account creation"));
    }
 
-   logcreation_action logcreation{get_self(), {get_self(), "active"_n}};
-   logcreation.send(account, from, excess, cost, current_time_point().time_since_epoch().count());
+   config_table   _config(get_self(), get_self().value);
+   auto           config    = _config.get_or_default();
+   const uint64_t timestamp = current_time_point().time_since_epoch().count();
+   for (size_t i = 0; i < accounts.size(); i++) {
+      const asset account_excess = batch ? asset(0, PAYMENT_TOKEN) : excess;
+      record_creation(config, accounts[i].first, from, account_excess, costs[i], timestamp);
+   }
+   if (config.receipt_table) {
+      _config.set(config, get_self());
+   }
 }
 
-[[eosio::action, eosio::read_only]] asset create::estimatecost()
+void create::send_creation(name                          account,
+                           const eosiosystem::authority& owner,
+                           const eosiosystem::authority& active,
+                           asset                         ram)
 {
-   return antelope::ram_cost_with_fee(BYTES_FOR_CREATION, PAYMENT_TOKEN);
+   system_contract::newaccount_action newaccount{SYSTEM_CONTRACT, {get_self(), "active"_n}};
+   newaccount.send(get_self(), account, owner, active);
+
+   system_contract::buyram_action buyram{SYSTEM_CONTRACT_PROXY, {get_self(), "active"_n}};
+   buyram.send(get_self(), account, ram);
+}
+
+void create::record_creation(config_row& config, name account, name from, asset excess, asset ram, uint64_t timestamp)
+{
+   if (!config.receipt_table) {
+      logcreation_action logcreation{get_self(), {get_self(), "active"_n}};
+      logcreation.send(account, from, excess, ram, timestamp);
+      return;
+   }
+
+   // Receipts overwrite the oldest slot, so the table never holds more than CREATION_RECEIPT_SLOTS rows
+   const receipt_row receipt = {
+      .slot      = config.next_receipt % CREATION_RECEIPT_SLOTS,
+      .sequence  = config.next_receipt,
+      .account   = account,
+      .from      = from,
+      .excess    = excess,
+      .ram       = ram,
+      .timestamp = timestamp,
+   };
+   config.next_receipt++;
+
+   receipts_table receipts(get_self(), get_self().value);
+   auto           itr = receipts.find(receipt.slot);
+   if (itr == receipts.end()) {
+      receipts.emplace(get_self(), [&](auto& row) { row = receipt; });
+   } else {
+      receipts.modify(itr, same_payer, [&](auto& row) { row = receipt; });
+   }
+}
+
+void create::log_creation(name account, name from, asset ram)
+{
+   config_table   _config(get_self(), get_self().value);
+   auto           config    = _config.get_or_default();
+   const uint64_t timestamp = current_time_point().time_since_epoch().count();
+   record_creation(config, account, from, asset(0, PAYMENT_TOKEN), ram, timestamp);
+   if (config.receipt_table) {
+      _config.set(config, get_self());
+   }
+}
+
+[[eosio::action]] void create::setreceipts(bool receipt_table)
+{
+   require_auth(get_self());
+   config_table _config(get_self(), get_self().value);
+   auto         config = _config.get_or_default();
+
+   config.receipt_table = receipt_table;
+   _config.set(config, get_self());
+}
+
+[[eosio::action, eosio::read_only]] asset
+create::estimatecost(const binary_extension<eosiosystem::authority> owner,
+                     const binary_extension<eosiosystem::authority> active)
+{
+   check(owner.has_value() == active.has_value(), "owner and active must be provided together");
+
+   // A memo may carry any single key, so without authorities the quote covers the largest one and is never below what
+   // a memo creation is charged, the difference is refunded with the excess
+   int64_t bytes = largest_key_creation_bytes();
+   if (owner.has_value()) {
+      bytes = creation_bytes(owner.value(), active.value());
+   }
+   return antelope::ram_market(PAYMENT_TOKEN, SYSTEM_CONTRACT).cost_with_fee(bytes);
+}
+
+[[eosio::action, eosio::read_only]] estimate_response
+create::estimate(const uint32_t extra_bytes, const string key_format, const uint32_t count)
+{
+   check(count > 0 && count <= MAX_ESTIMATE_COUNT, "count must be between 1 and 1000");
+
+   // Key types share a size, WebAuthn keys vary with their rpid so a sample key is needed to size them
+   check(key_format != "WA", "WebAuthn estimates require a sample PUB_WA_ key");
+   int64_t bytes = BYTES_FOR_CREATION;
+   if (!key_format.empty() && key_format != "K1" && key_format != "R1") {
+      const auto auth = parse_authority(key_format);
+      bytes           = creation_bytes(auth, auth);
+   }
+   bytes += extra_bytes;
+
+   const antelope::ram_market market(PAYMENT_TOKEN, SYSTEM_CONTRACT);
+   estimate_response          response = {
+      .bytes = bytes,
+      .cost  = market.cost_with_fee(bytes),
+      .total = asset(0, PAYMENT_TOKEN),
+   };
+   for (uint32_t i = 0; i < count; i++) {
+      response.total += market.cost_with_fee(bytes, uint64_t(i) * bytes);
+   }
+   return response;
 }
 
 [[eosio::action]] void create::logcreation(name account, name from, asset excess, asset ram, uint64_t timestamp)
@@ -16,6 +16,7 @@ public:
    static constexpr name     SYSTEM_CONTRACT      = "eosio"_n;
    static constexpr uint32_t QUOTA_WINDOW_SECONDS = 86400;
    static constexpr int64_t  GIFT_ROW_OVERHEAD    = 136;
+   static constexpr uint32_t USAGE_HISTORY_DAYS   = 30;
 
    struct [[eosio::table("creators")]] creator_row
    {
@@ -29,19 +30,101 @@ public:
 
    typedef eosio::multi_index<"creators"_n, creator_row> creators_table;
 
+   // Additional quota windows of a creator, scoped by creator, each charged independently of the creator row and of
+   // the other shards so parallel onboarding pipelines never write the same row
+   struct [[eosio::table("shards")]] shard_row
+   {
+      uint64_t       shard;
+      int64_t        daily_quota_bytes;
+      int64_t        used_bytes;
+      time_point_sec window_start;
+
+      uint64_t primary_key() const { return shard; }
+   };
+
+   typedef eosio::multi_index<"shards"_n, shard_row> shards_table;
+
+   // Contract-wide cap on the quota assigned to creators and shards, absent when no budget is set
+   struct [[eosio::table("config")]] config_row
+   {
+      int64_t daily_budget_bytes = 0;
+      int64_t allocated_bytes    = 0;
+   };
+   typedef eosio::singleton<"config"_n, config_row> config_table;
+
+   // Bytes charged per UTC day for creators with usage tracking enabled, as a ring indexed by day % USAGE_HISTORY_DAYS
+   struct [[eosio::table("usage")]] usage_row
+   {
+      name            creator;
+      uint32_t        last_day;
+      vector<int64_t> days;
+
+      uint64_t primary_key() const { return creator.value; }
+   };
+
+   typedef eosio::multi_index<"usage"_n, usage_row> usage_table;
+
+   // Usage ring of a single shard, scoped by creator, so gifts charged to a shard never write the creator's usage row
+   struct [[eosio::table("shardusage")]] shard_usage_row
+   {
+      uint64_t        shard;
+      uint32_t        last_day;
+      vector<int64_t> days;
+
+      uint64_t primary_key() const { return shard; }
+   };
+
+   typedef eosio::multi_index<"shardusage"_n, shard_usage_row> shard_usage_table;
+
+   struct quota_response
+   {
+      name              creator;
+      bool              registered        = false;
+      int64_t           daily_quota_bytes = 0;
+      int64_t           used_bytes        = 0;
+      int64_t           remaining_bytes   = 0;
+      int64_t           giftable_bytes    = 0; // largest single gift, remaining bytes less the giftedram row overhead
+      time_point_sec    window_start;
+      vector<int64_t>   daily_usage; // oldest to newest UTC day across the creator and its shards, empty unless tracked
+      vector<shard_row> shards;
+   };
+
    [[eosio::action]] void addcreator(name creator, int64_t daily_quota_bytes);
    [[eosio::action]] void rmcreator(name creator);
    [[eosio::action]] void setquota(name creator, int64_t daily_quota_bytes);
-   [[eosio::action]] void giftacct(name creator, name account, int64_t bytes, string memo);
+   [[eosio::action]] void setshard(name creator, uint64_t shard, int64_t daily_quota_bytes);
+   [[eosio::action]] void rmshard(name creator, uint64_t shard);
+   [[eosio::action]] void setbudget(int64_t daily_budget_bytes);
+   [[eosio::action]] void
+   giftacct(name creator, name account, int64_t bytes, string memo, const binary_extension<uint64_t> shard);
+   [[eosio::action]] void giftaccts(name                             creator,
+                                    vector<pair<name, int64_t>>      gifts,
+                                    string                           memo,
+                                    const binary_extension<uint64_t> shard);
+   [[eosio::action]] void trackusage(name creator, bool enabled);
+
+   [[eosio::action, eosio::read_only]] vector<quota_response> getquota(vector<name> creators);
 
    using addcreator_action = eosio::action_wrapper<"addcreator"_n, &gift::addcreator>;
    using rmcreator_action  = eosio::action_wrapper<"rmcreator"_n, &gift::rmcreator>;
    using setquota_action   = eosio::action_wrapper<"setquota"_n, &gift::setquota>;
+   using setshard_action   = eosio::action_wrapper<"setshard"_n, &gift::setshard>;
+   using rmshard_action    = eosio::action_wrapper<"rmshard"_n, &gift::rmshard>;
+   using setbudget_action  = eosio::action_wrapper<"setbudget"_n, &gift::setbudget>;
    using giftacct_action   = eosio::action_wrapper<"giftacct"_n, &gift::giftacct>;
+   using giftaccts_action  = eosio::action_wrapper<"giftaccts"_n, &gift::giftaccts>;
+   using trackusage_action = eosio::action_wrapper<"trackusage"_n, &gift::trackusage>;
+   using getquota_action   = eosio::action_wrapper<"getquota"_n, &gift::getquota>;
 
 #ifdef DEBUG
    [[eosio::action]] void reset();
 #endif
+
+private:
+   void    record_usage(name creator, const binary_extension<uint64_t>& shard, int64_t bytes);
+   void    clear_shard_usage(name creator);
+   void    allocate_quota(int64_t bytes);
+   int64_t charge_quota(name creator, const binary_extension<uint64_t>& shard, const vector<int64_t>& gifts);
 };
 
 } // namespace vaultacontracts
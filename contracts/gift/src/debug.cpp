@@ -6,8 +6,23 @@ void gift::reset()
    creators_table creators(get_self(), get_self().value);
    auto           itr = creators.begin();
    while (itr != creators.end()) {
+      shards_table shards(get_self(), itr->creator.value);
+      auto         shard_itr = shards.begin();
+      while (shard_itr != shards.end()) {
+         shard_itr = shards.erase(shard_itr);
+      }
+      clear_shard_usage(itr->creator);
       itr = creators.erase(itr);
    }
+
+   config_table _config(get_self(), get_self().value);
+   _config.remove();
+
+   usage_table usage(get_self(), get_self().value);
+   auto        usage_itr = usage.begin();
+   while (usage_itr != usage.end()) {
+      usage_itr = usage.erase(usage_itr);
+   }
 }
 
 } // namespace vaultacontracts
@@ -2,27 +2,76 @@
 
 #include <eosio/transaction.hpp>
 
+#include <algorithm>
+
 namespace vaultacontracts {
 
-static bool created_in_transaction(name account)
+static void skip_bytes(datastream<const char*>& ds, size_t bytes)
+{
+   check(ds.skip(bytes), "failed to read transaction");
+}
+
+// Returns every account created by eosio::newaccount in the current transaction, sorted for lookups. The packed
+// transaction is walked in place, reading only action names and the first two fields of newaccount data, and
+// skipping everything else by its length prefix.
+static vector<name> created_in_transaction()
 {
    auto              size = eosio::transaction_size();
    std::vector<char> buffer(size);
    check(eosio::read_transaction(buffer.data(), size) == size, "failed to read transaction");
-   auto trx = eosio::unpack<eosio::transaction>(buffer.data(), size);
-   for (const auto& act : trx.actions) {
-      if (act.account != gift::SYSTEM_CONTRACT || act.name != "newaccount"_n) {
-         continue;
-      }
-      datastream<const char*> ds(act.data.data(), act.data.size());
-      name                    creator;
-      name                    created;
-      ds >> creator >> created;
-      if (created == account) {
-         return true;
+   datastream<const char*> ds(buffer.data(), size);
+
+   // transaction_header: expiration, ref_block_num, ref_block_prefix, max_net_usage_words, max_cpu_usage_ms, delay_sec
+   unsigned_int max_net_usage_words;
+   uint8_t      max_cpu_usage_ms;
+   unsigned_int delay_sec;
+   skip_bytes(ds, sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint32_t));
+   ds >> max_net_usage_words >> max_cpu_usage_ms >> delay_sec;
+
+   // context_free_actions are walked only to reach actions, they cannot create accounts
+   vector<name> created;
+   for (const bool context_free : {true, false}) {
+      unsigned_int action_count;
+      ds >> action_count;
+      for (uint32_t i = 0; i < action_count.value; i++) {
+         name         account;
+         name         action_name;
+         unsigned_int authorization_count;
+         unsigned_int data_size;
+         ds >> account >> action_name >> authorization_count;
+         skip_bytes(ds, size_t(authorization_count.value) * sizeof(permission_level));
+         ds >> data_size;
+
+         if (!context_free && account == gift::SYSTEM_CONTRACT && action_name == "newaccount"_n) {
+            datastream<const char*> data(ds.pos(), data_size.value);
+            name                    creator;
+            name                    new_account;
+            data >> creator >> new_account;
+            created.push_back(new_account);
+         }
+         skip_bytes(ds, data_size.value);
       }
    }
-   return false;
+   sort(created.begin(), created.end());
+   return created;
+}
+
+static bool created_in_transaction(name account)
+{
+   const auto created = created_in_transaction();
+   return binary_search(created.begin(), created.end(), account);
+}
+
+// Returns the creator or shard row as of now, rolling over to a new quota window once a full QUOTA_WINDOW_SECONDS has
+// elapsed
+template <typename T>
+static T current_window(T row, time_point_sec now)
+{
+   if (now.sec_since_epoch() >= row.window_start.sec_since_epoch() + gift::QUOTA_WINDOW_SECONDS) {
+      row.used_bytes   = 0;
+      row.window_start = now;
+   }
+   return row;
 }
 
 void gift::addcreator(name creator, int64_t daily_quota_bytes)
@@ -33,6 +82,7 @@ void gift::addcreator(name creator, int64_t daily_quota_bytes)
 
    creators_table creators(get_self(), get_self().value);
    check(creators.find(creator.value) == creators.end(), "creator already registered");
+   allocate_quota(daily_quota_bytes);
 
    creators.emplace(get_self(), [&](auto& row) {
       row.creator           = creator;
@@ -47,7 +97,23 @@ void gift::rmcreator(name creator)
    require_auth(get_self());
    creators_table creators(get_self(), get_self().value);
    auto           itr = creators.require_find(creator.value, "creator not registered");
+
+   int64_t      released = itr->daily_quota_bytes;
+   shards_table shards(get_self(), creator.value);
+   auto         shard_itr = shards.begin();
+   while (shard_itr != shards.end()) {
+      released  += shard_itr->daily_quota_bytes;
+      shard_itr  = shards.erase(shard_itr);
+   }
    creators.erase(itr);
+   allocate_quota(-released);
+
+   usage_table usage(get_self(), get_self().value);
+   auto        usage_itr = usage.find(creator.value);
+   if (usage_itr != usage.end()) {
+      usage.erase(usage_itr);
+   }
+   clear_shard_usage(creator);
 }
 
 void gift::setquota(name creator, int64_t daily_quota_bytes)
@@ -56,42 +122,62 @@ void gift::setquota(name creator, int64_t daily_quota_bytes)
    check(daily_quota_bytes > 0, "quota must be positive");
    creators_table creators(get_self(), get_self().value);
    auto           itr = creators.require_find(creator.value, "creator not registered");
+   allocate_quota(daily_quota_bytes - itr->daily_quota_bytes);
    creators.modify(itr, same_payer, [&](auto& row) { row.daily_quota_bytes = daily_quota_bytes; });
 }
 
-void gift::giftacct(name creator, name account, int64_t bytes, string memo)
+void gift::giftacct(name creator, name account, int64_t bytes, string memo, const binary_extension<uint64_t> shard)
 {
    require_auth(creator);
    check(bytes > 0, "must gift positive bytes");
    check(is_account(account), "account does not exist");
    check(memo.size() <= 256, "memo has more than 256 bytes");
 
-   creators_table creators(get_self(), get_self().value);
-   auto           itr = creators.require_find(creator.value, "creator not registered");
+   const int64_t charged = charge_quota(creator, shard, {bytes});
+   check(created_in_transaction(account), "account must be created by eosio::newaccount in the same transaction");
+   record_usage(creator, shard, charged);
 
-   auto           now          = time_point_sec(current_time_point());
-   int64_t        used         = itr->used_bytes;
-   time_point_sec window_start = itr->window_start;
-   if (now.sec_since_epoch() >= window_start.sec_since_epoch() + QUOTA_WINDOW_SECONDS) {
-      used         = 0;
-      window_start = now;
-   }
-   int64_t remaining = itr->daily_quota_bytes - used;
-   check(remaining >= GIFT_ROW_OVERHEAD && bytes <= remaining - GIFT_ROW_OVERHEAD, "daily quota exceeded");
+   eosiosystem::system_contract::giftram_action giftram{SYSTEM_CONTRACT, {{get_self(), "active"_n}}};
+   giftram.send(get_self(), account, bytes, memo);
+}
 
-   check(created_in_transaction(account), "account must be created by eosio::newaccount in the same transaction");
+void gift::giftaccts(name                             creator,
+                     vector<pair<name, int64_t>>      gifts,
+                     string                           memo,
+                     const binary_extension<uint64_t> shard)
+{
+   require_auth(creator);
+   check(!gifts.empty(), "no gifts provided");
+   check(memo.size() <= 256, "memo has more than 256 bytes");
 
-   creators.modify(itr, same_payer, [&](auto& row) {
-      row.used_bytes   = used + bytes + GIFT_ROW_OVERHEAD;
-      row.window_start = window_start;
-   });
+   vector<int64_t> amounts;
+   amounts.reserve(gifts.size());
+   for (const auto& [account, bytes] : gifts) {
+      check(bytes > 0, "must gift positive bytes");
+      check(is_account(account), "account does not exist");
+      amounts.push_back(bytes);
+   }
+   const int64_t charged = charge_quota(creator, shard, amounts);
+
+   // The transaction is parsed once for every gift in the batch
+   const auto created = created_in_transaction();
+   for (const auto& [account, bytes] : gifts) {
+      check(binary_search(created.begin(), created.end(), account),
+            "account must be created by eosio::newaccount in the same transaction");
+   }
+   record_usage(creator, shard, charged);
 
    eosiosystem::system_contract::giftram_action giftram{SYSTEM_CONTRACT, {{get_self(), "active"_n}}};
-   giftram.send(get_self(), account, bytes, memo);
+   for (const auto& [account, bytes] : gifts) {
+      giftram.send(get_self(), account, bytes, memo);
+   }
 }
 
 } // namespace vaultacontracts
 
+#include "quota.cpp"
+#include "usage.cpp"
+
 #ifdef DEBUG
 #include "debug.cpp"
 #endif
@@ -0,0 +1,122 @@
+namespace vaultacontracts {
+
+// Checks each gift against what remains of the window in order and returns the total bytes charged
+template <typename T>
+static int64_t charge_window(T& window, const vector<int64_t>& gifts)
+{
+   int64_t charged = 0;
+   for (const int64_t bytes : gifts) {
+      int64_t remaining = window.daily_quota_bytes - window.used_bytes;
+      check(remaining >= gift::GIFT_ROW_OVERHEAD && bytes <= remaining - gift::GIFT_ROW_OVERHEAD,
+            "daily quota exceeded");
+      window.used_bytes += bytes + gift::GIFT_ROW_OVERHEAD;
+      charged           += bytes + gift::GIFT_ROW_OVERHEAD;
+   }
+   return charged;
+}
+
+int64_t gift::charge_quota(name creator, const binary_extension<uint64_t>& shard, const vector<int64_t>& gifts)
+{
+   const auto     now = time_point_sec(current_time_point());
+   creators_table creators(get_self(), get_self().value);
+   auto           itr = creators.require_find(creator.value, "creator not registered");
+
+   if (!shard.has_value()) {
+      auto          window  = current_window(*itr, now);
+      const int64_t charged = charge_window(window, gifts);
+      creators.modify(itr, same_payer, [&](auto& row) {
+         row.used_bytes   = window.used_bytes;
+         row.window_start = window.window_start;
+      });
+      return charged;
+   }
+
+   // A shard is charged on its own, the creator row is only read
+   shards_table  shards(get_self(), creator.value);
+   auto          shard_itr = shards.require_find(shard.value(), "shard not found");
+   auto          window    = current_window(*shard_itr, now);
+   const int64_t charged   = charge_window(window, gifts);
+   shards.modify(shard_itr, same_payer, [&](auto& row) {
+      row.used_bytes   = window.used_bytes;
+      row.window_start = window.window_start;
+   });
+   return charged;
+}
+
+void gift::allocate_quota(int64_t bytes)
+{
+   config_table _config(get_self(), get_self().value);
+   if (!_config.exists()) {
+      return;
+   }
+
+   auto config             = _config.get();
+   config.allocated_bytes += bytes;
+   check(bytes <= 0 || config.allocated_bytes <= config.daily_budget_bytes, "daily budget exceeded");
+   _config.set(config, get_self());
+}
+
+void gift::setshard(name creator, uint64_t shard, int64_t daily_quota_bytes)
+{
+   require_auth(get_self());
+   check(daily_quota_bytes > 0, "quota must be positive");
+   creators_table creators(get_self(), get_self().value);
+   creators.require_find(creator.value, "creator not registered");
+
+   shards_table shards(get_self(), creator.value);
+   auto         itr = shards.find(shard);
+   if (itr == shards.end()) {
+      allocate_quota(daily_quota_bytes);
+      shards.emplace(get_self(), [&](auto& row) {
+         row.shard             = shard;
+         row.daily_quota_bytes = daily_quota_bytes;
+         row.used_bytes        = 0;
+         row.window_start      = time_point_sec(current_time_point());
+      });
+      return;
+   }
+   allocate_quota(daily_quota_bytes - itr->daily_quota_bytes);
+   shards.modify(itr, same_payer, [&](auto& row) { row.daily_quota_bytes = daily_quota_bytes; });
+}
+
+void gift::rmshard(name creator, uint64_t shard)
+{
+   require_auth(get_self());
+   shards_table shards(get_self(), creator.value);
+   auto         itr = shards.require_find(shard, "shard not found");
+   allocate_quota(-itr->daily_quota_bytes);
+   shards.erase(itr);
+
+   shard_usage_table shard_usage(get_self(), creator.value);
+   auto              usage_itr = shard_usage.find(shard);
+   if (usage_itr != shard_usage.end()) {
+      shard_usage.erase(usage_itr);
+   }
+}
+
+void gift::setbudget(int64_t daily_budget_bytes)
+{
+   require_auth(get_self());
+   check(daily_budget_bytes >= 0, "budget must not be negative");
+   config_table _config(get_self(), get_self().value);
+   if (daily_budget_bytes == 0) {
+      _config.remove();
+      return;
+   }
+
+   // Quota assigned while no budget was set is not tracked, so the allocation is recounted from the tables
+   int64_t        allocated = 0;
+   creators_table creators(get_self(), get_self().value);
+   for (const auto& creator : creators) {
+      allocated += creator.daily_quota_bytes;
+      shards_table shards(get_self(), creator.creator.value);
+      for (const auto& shard : shards) {
+         allocated += shard.daily_quota_bytes;
+      }
+   }
+   check(allocated <= daily_budget_bytes, "budget is below the allocated quota");
+
+   _config.set(config_row{.daily_budget_bytes = daily_budget_bytes, .allocated_bytes = allocated}, get_self());
+}
+
+} // namespace vaultacontracts
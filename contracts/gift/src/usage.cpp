@@ -0,0 +1,137 @@
+namespace vaultacontracts {
+
+// Moves the ring forward to day, clearing the slots of days without gifts since the last update
+template <typename T>
+static void advance_usage(T& row, uint32_t day)
+{
+   for (uint32_t d = row.last_day + 1; d <= day && d <= row.last_day + gift::USAGE_HISTORY_DAYS; d++) {
+      row.days[d % gift::USAGE_HISTORY_DAYS] = 0;
+   }
+   if (day > row.last_day) {
+      row.last_day = day;
+   }
+}
+
+static uint32_t usage_day(time_point_sec time)
+{
+   return time.sec_since_epoch() / 86400;
+}
+
+void gift::record_usage(name creator, const binary_extension<uint64_t>& shard, int64_t bytes)
+{
+   usage_table usage(get_self(), get_self().value);
+   auto        itr = usage.find(creator.value);
+   if (itr == usage.end()) {
+      return;
+   }
+
+   const uint32_t day = usage_day(time_point_sec(current_time_point()));
+   if (!shard.has_value()) {
+      usage.modify(itr, same_payer, [&](auto& row) {
+         advance_usage(row, day);
+         row.days[day % USAGE_HISTORY_DAYS] += bytes;
+      });
+      return;
+   }
+
+   // Shard gifts only read the creator's usage row to see whether tracking is enabled, and write their own ring
+   shard_usage_table shard_usage(get_self(), creator.value);
+   auto              shard_itr = shard_usage.find(shard.value());
+   if (shard_itr == shard_usage.end()) {
+      shard_usage.emplace(get_self(), [&](auto& row) {
+         row.shard                          = shard.value();
+         row.last_day                       = day;
+         row.days                           = vector<int64_t>(USAGE_HISTORY_DAYS, 0);
+         row.days[day % USAGE_HISTORY_DAYS] = bytes;
+      });
+      return;
+   }
+   shard_usage.modify(shard_itr, same_payer, [&](auto& row) {
+      advance_usage(row, day);
+      row.days[day % USAGE_HISTORY_DAYS] += bytes;
+   });
+}
+
+void gift::clear_shard_usage(name creator)
+{
+   shard_usage_table shard_usage(get_self(), creator.value);
+   auto              itr = shard_usage.begin();
+   while (itr != shard_usage.end()) {
+      itr = shard_usage.erase(itr);
+   }
+}
+
+void gift::trackusage(name creator, bool enabled)
+{
+   require_auth(get_self());
+   creators_table creators(get_self(), get_self().value);
+   creators.require_find(creator.value, "creator not registered");
+
+   usage_table usage(get_self(), get_self().value);
+   auto        itr = usage.find(creator.value);
+   if (!enabled) {
+      check(itr != usage.end(), "usage not tracked");
+      usage.erase(itr);
+      clear_shard_usage(creator);
+      return;
+   }
+   check(itr == usage.end(), "usage already tracked");
+   usage.emplace(get_self(), [&](auto& row) {
+      row.creator  = creator;
+      row.last_day = usage_day(time_point_sec(current_time_point()));
+      row.days     = vector<int64_t>(USAGE_HISTORY_DAYS, 0);
+   });
+}
+
+[[eosio::action, eosio::read_only]] vector<gift::quota_response> gift::getquota(vector<name> creators)
+{
+   creators_table _creators(get_self(), get_self().value);
+   usage_table    usage(get_self(), get_self().value);
+   const auto     now = time_point_sec(current_time_point());
+
+   vector<quota_response> responses;
+   responses.reserve(creators.size());
+   for (const auto& creator : creators) {
+      quota_response response = {.creator = creator};
+
+      auto creator_itr = _creators.find(creator.value);
+      if (creator_itr != _creators.end()) {
+         // Apply the same rollover giftacct would, so remaining bytes reflect what a gift submitted now may use
+         const auto window          = current_window(*creator_itr, now);
+         response.registered        = true;
+         response.daily_quota_bytes = window.daily_quota_bytes;
+         response.used_bytes        = window.used_bytes;
+         response.remaining_bytes   = window.daily_quota_bytes - window.used_bytes;
+         response.giftable_bytes    = std::max<int64_t>(response.remaining_bytes - GIFT_ROW_OVERHEAD, 0);
+         response.window_start      = window.window_start;
+
+         shards_table shards(get_self(), creator.value);
+         for (const auto& shard : shards) {
+            response.shards.push_back(current_window(shard, now));
+         }
+      }
+
+      auto usage_itr = usage.find(creator.value);
+      if (usage_itr != usage.end()) {
+         auto           row = *usage_itr;
+         const uint32_t day = usage_day(now);
+         advance_usage(row, day);
+
+         // Shard rings share the day slots of the creator ring, so they are added slot by slot
+         shard_usage_table shard_usage(get_self(), creator.value);
+         for (auto shard_row : shard_usage) {
+            advance_usage(shard_row, day);
+            for (uint32_t slot = 0; slot < USAGE_HISTORY_DAYS; slot++) {
+               row.days[slot] += shard_row.days[slot];
+            }
+         }
+         for (uint32_t i = 1; i <= USAGE_HISTORY_DAYS; i++) {
+            response.daily_usage.push_back(row.days[(day + i) % USAGE_HISTORY_DAYS]);
+         }
+      }
+      responses.push_back(response);
+   }
+   return responses;
+}
+
+} // namespace vaultacontracts
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <eosio.system/exchange_state.hpp>
 #include <eosio/eosio.hpp>
 
 using namespace eosio;
@@ -26,6 +27,7 @@ public:
    [[eosio::action]] void newaccount(name creator, name account);
    [[eosio::action]] void giftram(name from, name to, int64_t bytes, string memo);
    [[eosio::action]] void ungiftram(name from, name to, string memo);
+   [[eosio::action]] void setrammarket(int64_t ram_reserve, asset core_reserve);
 };
 
 } // namespace vaultacontracts
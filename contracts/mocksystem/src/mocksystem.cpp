@@ -38,4 +38,25 @@ void mocksystem::ungiftram(name from, name to, string memo)
    giftedram.erase(itr);
 }
 
+// Writes the RAMCORE row of rammarket with the given reserves, in the layout the system contract uses
+void mocksystem::setrammarket(int64_t ram_reserve, asset core_reserve)
+{
+   require_auth(get_self());
+
+   const symbol           ramcore_symbol = symbol("RAMCORE", 4);
+   eosiosystem::rammarket rammarket(get_self(), get_self().value);
+   auto                   itr = rammarket.find(ramcore_symbol.raw());
+
+   auto set_reserves = [&](auto& row) {
+      row.supply        = asset(100000000000000, ramcore_symbol);
+      row.base.balance  = asset(ram_reserve, symbol("RAM", 0));
+      row.quote.balance = core_reserve;
+   };
+   if (itr == rammarket.end()) {
+      rammarket.emplace(get_self(), set_reserves);
+   } else {
+      rammarket.modify(itr, same_payer, set_reserves);
+   }
+}
+
 } // namespace vaultacontracts
@@ -216,22 +216,88 @@ public:
       eosio::indexed_by<"byticker"_n, eosio::const_mem_fun<allocation_row, uint64_t, &allocation_row::by_ticker>>>
       allocation_table;
 
+   // Running total of the allocations staged for a token, removed once they have all been paid out or cleared
+   struct [[eosio::table("staged")]] staged_row
+   {
+      asset quantity;
+      asset paid; // paid out by execalloc so far, staging can only be cleared while this is zero
+
+      uint64_t primary_key() const { return quantity.symbol.code().raw(); }
+   };
+
+   typedef eosio::multi_index<"staged"_n, staged_row> staged_table;
+
    [[eosio::action]] void setconfig(const name registry);
    using setconfig_action = eosio::action_wrapper<"setconfig"_n, &tokens::setconfig>;
 
    [[eosio::action]] void setsupply(const symbol_code& ticker, const asset& supply);
    using setsupply_action = eosio::action_wrapper<"setsupply"_n, &tokens::setsupply>;
 
+   /**
+    * Distributes the full supply held by the contract to the allocation receivers, then closes the contract balance.
+    *
+    * @param ticker - the token to distribute,
+    * @param allocations - the receivers and quantities, which must add up to the supply,
+    * @param direct - credit the receiver balances in this action instead of sending one inline transfer each, with a
+    * single logdistrib action in place of the per-receiver transfer notifications.
+    */
    [[eosio::action]] void distribute(const symbol_code&                             ticker,
-                                     const std::vector<antelope::token_allocation>& allocations);
+                                     const std::vector<antelope::token_allocation>& allocations,
+                                     const binary_extension<bool>                   direct);
    using distribute_action = eosio::action_wrapper<"distribute"_n, &tokens::distribute>;
 
+   /**
+    * Appends a chunk of allocations to the staged distribution of a token, for distributions too large to fit in one
+    * transaction. The running total may never exceed the supply.
+    *
+    * @param ticker - the token to distribute,
+    * @param chunk - the receivers and quantities to add.
+    */
+   [[eosio::action]] void stagealloc(const symbol_code& ticker, const std::vector<antelope::token_allocation>& chunk);
+   using stagealloc_action = eosio::action_wrapper<"stagealloc"_n, &tokens::stagealloc>;
+
+   /**
+    * Pays out up to `max_rows` staged allocations once they add up to the supply, and closes the contract balance
+    * after the last one. Anyone may call it. A receiver balance closed after staging is reopened with the contract as
+    * RAM payer.
+    *
+    * @param ticker - the token to distribute,
+    * @param max_rows - the maximum number of allocations to pay out.
+    */
+   [[eosio::action]] void execalloc(const symbol_code& ticker, const uint32_t max_rows);
+   using execalloc_action = eosio::action_wrapper<"execalloc"_n, &tokens::execalloc>;
+
+   /**
+    * Removes up to `max_rows` staged allocations of a token so a mistaken staging can be corrected, and removes the
+    * staged total once none remain. Only allowed before `execalloc` has paid anything out.
+    *
+    * @param ticker - the token whose staged allocations are cleared,
+    * @param max_rows - the maximum number of allocations to remove.
+    */
+   [[eosio::action]] void clearalloc(const symbol_code& ticker, const uint32_t max_rows);
+   using clearalloc_action = eosio::action_wrapper<"clearalloc"_n, &tokens::clearalloc>;
+
+   [[eosio::action]] void logdistrib(const symbol_code& ticker, const asset& quantity, const uint32_t receivers);
+   using logdistrib_action = eosio::action_wrapper<"logdistrib"_n, &tokens::logdistrib>;
+
    vaultacontracts::registry::token_row get_token(const config_row& config, const symbol_code& ticker);
 
    [[eosio::action]]
    void transfer2(const name& from, const name& to, const asset& quantity, const string& memo);
    using transfer2_action = eosio::action_wrapper<"transfer2"_n, &tokens::transfer2>;
 
+   /**
+    * Allows `from` account to transfer to many accounts at once, with the same RAM payer rules as `transfer2`. The
+    * stat row and the `from` balance are read once per symbol, and every recipient is notified of this action.
+    *
+    * @param from - the account to transfer from,
+    * @param transfers - the accounts to be transferred to and the quantity each receives,
+    * @param memo - the memo string to accompany the transaction.
+    */
+   [[eosio::action]]
+   void transfers(const name& from, const std::vector<std::pair<name, asset>>& transfers, const string& memo);
+   using transfers_action = eosio::action_wrapper<"transfers"_n, &tokens::transfers>;
+
 #ifdef DEBUG
    [[eosio::action]] void reset(const std::vector<eosio::symbol> testsymbols, const std::vector<name> testaccounts);
 #endif
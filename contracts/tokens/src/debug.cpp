@@ -16,6 +16,12 @@ void tokens::clear_table(T& table, uint64_t rows_to_clear)
    config_table _config(get_self(), get_self().value);
    _config.remove();
 
+   tokens::allocation_table _allocations(get_self(), get_self().value);
+   clear_table(_allocations, -1);
+
+   tokens::staged_table _staged(get_self(), get_self().value);
+   clear_table(_staged, -1);
+
    for (auto symbol : testsymbols) {
       tokens::stats _stats(get_self(), symbol.code().raw());
       clear_table(_stats, -1);
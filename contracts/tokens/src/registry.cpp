@@ -1,6 +1,8 @@
 #include <registry/registry.hpp>
 #include <tokens/tokens.hpp>
 
+#include <algorithm>
+
 namespace vaultacontracts {
 
 [[eosio::action]] void tokens::setconfig(const name registry)
@@ -22,7 +24,8 @@ vaultacontracts::registry::token_row tokens::get_token(const config_row& config,
 }
 
 [[eosio::action]] void tokens::distribute(const symbol_code&                             ticker,
-                                          const std::vector<antelope::token_allocation>& allocations)
+                                          const std::vector<antelope::token_allocation>& allocations,
+                                          const binary_extension<bool>                   direct)
 {
    check(allocations.size() > 0, "must provide at least one token allocation");
 
@@ -47,9 +50,29 @@ vaultacontracts::registry::token_row tokens::get_token(const config_row& config,
    check(account_itr != accounts.end(), "contract balance not found");
    check(account_itr->balance == stat_itr->max_supply, "token has already been distributed");
 
+   staged_table staged(get_self(), get_self().value);
+   check(staged.find(ticker.raw()) == staged.end(), "allocations are staged for this token");
+
    // Validate allocations against supply
    antelope::check_allocations(stat_itr->max_supply, allocations);
 
+   if (direct.value_or(false)) {
+      // Credit every receiver in place, the contract balance is fully allocated so it is closed rather than debited
+      for (const auto& allocation : allocations) {
+         check(allocation.receiver != get_self(), "cannot transfer to self");
+         tokens::accounts receiver_accounts(get_self(), allocation.receiver.value);
+         auto             open_itr = receiver_accounts.find(ticker.raw());
+         check(open_itr != receiver_accounts.end(),
+               "balance must be opened first for: " + allocation.receiver.to_string());
+         receiver_accounts.modify(open_itr, same_payer, [&](auto& a) { a.balance += allocation.quantity; });
+      }
+      accounts.erase(account_itr);
+
+      logdistrib_action logdistrib{get_self(), {{get_self(), eosiosystem::system_contract::active_permission}}};
+      logdistrib.send(ticker, stat_itr->max_supply, allocations.size());
+      return;
+   }
+
    // Perform the allocations
    for (const auto& allocation : allocations) {
       // Ensure each allocation goes to an account with an open balance
@@ -67,6 +90,158 @@ vaultacontracts::registry::token_row tokens::get_token(const config_row& config,
    close_act.send(get_self(), stat_itr->supply.symbol);
 }
 
+[[eosio::action]] void tokens::stagealloc(const symbol_code&                             ticker,
+                                          const std::vector<antelope::token_allocation>& chunk)
+{
+   check(chunk.size() > 0, "must provide at least one token allocation");
+
+   config_table _config(get_self(), get_self().value);
+   auto         config = _config.get_or_default();
+
+   // Retrieve the token from the registry contract
+   auto token = get_token(config, ticker);
+   check(token.contract == get_self(), "token is not registered to this contract");
+
+   require_auth(token.creator);
+
+   // Ensure the supply has been established and is still held by the contract
+   stats stats(get_self(), token.ticker.raw());
+   auto  stat_itr = stats.find(token.ticker.raw());
+   check(stat_itr != stats.end(), "supply not established");
+   check(stat_itr->supply == stat_itr->max_supply, "supply must be fully allocated");
+
+   tokens::accounts accounts(get_self(), get_self().value);
+   auto             account_itr = accounts.find(token.ticker.raw());
+   check(account_itr != accounts.end(), "contract balance not found");
+   check(account_itr->balance == stat_itr->max_supply, "token has already been distributed");
+
+   staged_table staged(get_self(), get_self().value);
+   auto         staged_itr = staged.find(ticker.raw());
+   asset        total      = staged_itr == staged.end() ? asset(0, stat_itr->max_supply.symbol) : staged_itr->quantity;
+
+   // Each chunk is validated as it is staged, so the total can never exceed the supply
+   allocation_table allocations(get_self(), get_self().value);
+   for (const auto& allocation : chunk) {
+      check(allocation.quantity.is_valid(), "invalid quantity");
+      check(allocation.quantity.amount > 0, "must allocate an amount greater than zero");
+      check(allocation.quantity.symbol == stat_itr->max_supply.symbol,
+            "allocation symbol does not match supply symbol");
+      check(allocation.receiver != get_self(), "cannot transfer to self");
+
+      tokens::accounts receiver_accounts(get_self(), allocation.receiver.value);
+      check(receiver_accounts.find(ticker.raw()) != receiver_accounts.end(),
+            "balance must be opened first for: " + allocation.receiver.to_string());
+
+      total += allocation.quantity;
+      check(total <= stat_itr->max_supply, "staged allocations exceed the supply");
+
+      allocations.emplace(token.creator, [&](auto& row) {
+         row.id       = allocations.available_primary_key();
+         row.ticker   = ticker;
+         row.receiver = allocation.receiver;
+         row.quantity = allocation.quantity;
+      });
+   }
+
+   if (staged_itr == staged.end()) {
+      staged.emplace(token.creator, [&](auto& row) {
+         row.quantity = total;
+         row.paid     = asset(0, total.symbol);
+      });
+   } else {
+      staged.modify(staged_itr, same_payer, [&](auto& row) { row.quantity = total; });
+   }
+}
+
+[[eosio::action]] void tokens::execalloc(const symbol_code& ticker, const uint32_t max_rows)
+{
+   check(max_rows > 0, "max_rows must be positive");
+
+   staged_table staged(get_self(), get_self().value);
+   auto         staged_itr = staged.require_find(ticker.raw(), "no staged allocations for token");
+
+   stats       stats(get_self(), ticker.raw());
+   const auto& st = stats.get(ticker.raw(), "supply not established");
+   check(staged_itr->quantity == st.max_supply, "staged allocations must match the supply");
+
+   tokens::accounts accounts(get_self(), get_self().value);
+   const auto&      contract_balance = accounts.get(ticker.raw(), "contract balance not found");
+
+   // Credit receivers in place and debit the contract balance once for the whole chunk
+   allocation_table allocations(get_self(), get_self().value);
+   auto             by_ticker = allocations.get_index<"byticker"_n>();
+   auto             itr       = by_ticker.lower_bound(ticker.raw());
+   asset            paid(0, st.max_supply.symbol);
+   uint32_t         rows = 0;
+   while (itr != by_ticker.end() && itr->ticker == ticker && rows < max_rows) {
+      // Balances were open when staged, a receiver that closed one since is reopened at the contract's expense so
+      // the payout can never be blocked
+      add_balance(itr->receiver, itr->quantity, get_self());
+
+      paid += itr->quantity;
+      rows++;
+      itr = by_ticker.erase(itr);
+   }
+
+   accounts.modify(contract_balance, same_payer, [&](auto& a) { a.balance -= paid; });
+
+   // Once every staged allocation is paid the contract balance is closed as distribute does, unless tokens were
+   // transferred to the contract in the meantime
+   if (itr == by_ticker.end() || itr->ticker != ticker) {
+      if (contract_balance.balance.amount == 0) {
+         accounts.erase(contract_balance);
+      }
+      staged.erase(staged_itr);
+   } else {
+      staged.modify(staged_itr, same_payer, [&](auto& row) { row.paid += paid; });
+   }
+
+   logdistrib_action logdistrib{get_self(), {{get_self(), eosiosystem::system_contract::active_permission}}};
+   logdistrib.send(ticker, paid, rows);
+}
+
+[[eosio::action]] void tokens::clearalloc(const symbol_code& ticker, const uint32_t max_rows)
+{
+   check(max_rows > 0, "max_rows must be positive");
+
+   config_table _config(get_self(), get_self().value);
+   auto         config = _config.get_or_default();
+
+   // Retrieve the token from the registry contract
+   auto token = get_token(config, ticker);
+   check(token.contract == get_self(), "token is not registered to this contract");
+
+   stats       stats(get_self(), ticker.raw());
+   const auto& st = stats.get(ticker.raw(), "supply not established");
+   check(has_auth(token.creator) || has_auth(st.issuer), "missing required authority " + token.creator.to_string());
+
+   staged_table staged(get_self(), get_self().value);
+   auto         staged_itr = staged.require_find(ticker.raw(), "no staged allocations for token");
+   check(staged_itr->paid.amount == 0, "staged allocations have already been paid out");
+
+   allocation_table allocations(get_self(), get_self().value);
+   auto             by_ticker = allocations.get_index<"byticker"_n>();
+   auto             itr       = by_ticker.lower_bound(ticker.raw());
+   asset            removed(0, st.max_supply.symbol);
+   uint32_t         rows = 0;
+   while (itr != by_ticker.end() && itr->ticker == ticker && rows < max_rows) {
+      removed += itr->quantity;
+      rows++;
+      itr = by_ticker.erase(itr);
+   }
+
+   if (itr == by_ticker.end() || itr->ticker != ticker) {
+      staged.erase(staged_itr);
+   } else {
+      staged.modify(staged_itr, same_payer, [&](auto& row) { row.quantity -= removed; });
+   }
+}
+
+[[eosio::action]] void tokens::logdistrib(const symbol_code& ticker, const asset& quantity, const uint32_t receivers)
+{
+   require_auth(get_self());
+}
+
 [[eosio::action]] void tokens::setsupply(const symbol_code& ticker, const asset& supply)
 {
    check(ticker == supply.symbol.code(), "ticker must match supply symbol");
@@ -127,6 +302,45 @@ void tokens::transfer2(const name& from, const name& to, const asset& quantity,
    add_balance(to, quantity, payer);
 }
 
+// Batched `transfer2`, debiting `from` once per symbol
+void tokens::transfers(const name& from, const std::vector<std::pair<name, asset>>& transfers, const string& memo)
+{
+   require_auth(from);
+   check(transfers.size() > 0, "must provide at least one transfer");
+   check(memo.size() <= 256, "memo has more than 256 bytes");
+
+   require_recipient(from);
+
+   std::vector<asset> totals;
+   for (const auto& [to, quantity] : transfers) {
+      check(from != to, "cannot transfer to self");
+      check(is_account(to), "to account does not exist");
+      check(quantity.is_valid(), "invalid quantity");
+      check(quantity.amount > 0, "must transfer positive quantity");
+
+      auto total = std::find_if(totals.begin(), totals.end(),
+                                [&](const asset& a) { return a.symbol.code() == quantity.symbol.code(); });
+      if (total == totals.end()) {
+         auto        sym = quantity.symbol.code();
+         stats       statstable(get_self(), sym.raw());
+         const auto& st = statstable.get(sym.raw());
+         total          = totals.insert(totals.end(), asset(0, st.supply.symbol));
+      }
+      check(quantity.symbol == total->symbol, "symbol precision mismatch");
+      *total += quantity;
+
+      require_recipient(to);
+   }
+
+   for (const auto& total : totals) {
+      sub_balance_same_payer(from, total);
+   }
+   for (const auto& [to, quantity] : transfers) {
+      auto payer = has_auth(to) ? to : from;
+      add_balance(to, quantity, payer);
+   }
+}
+
 // Mirror of `sub_balance` method, except the RAM payer uses `same_payer` instead of `owner`
 void tokens::sub_balance_same_payer(const name& owner, const asset& value)
 {
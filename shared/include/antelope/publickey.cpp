@@ -1,80 +1,93 @@
 #include "publickey.hpp"
 #include <cstring>
 #include <eosiolib/capi/eosio/crypto.h>
-#include <string_view>
 
 namespace antelope {
 
-bool DecodeBase58(const char* psz, vector<unsigned char>& vch)
+static std::string_view trim_whitespace(std::string_view str)
 {
-   while (*psz && isspace(*psz))
-      psz++;
-   int zeroes = 0;
-   int length = 0;
-   while (*psz == '1') {
+   while (!str.empty() && isspace(str.front()))
+      str.remove_prefix(1);
+   while (!str.empty() && isspace(str.back()))
+      str.remove_suffix(1);
+   return str;
+}
+
+size_t decode_base58(std::string_view str, base58_key_buffer& out)
+{
+   str = trim_whitespace(str);
+
+   size_t zeroes = 0;
+   while (zeroes < str.size() && str[zeroes] == '1')
       zeroes++;
-      psz++;
-   }
-   int                   size = strlen(psz) * 733 / 1000 + 1;
-   vector<unsigned char> b256(size);
-   static_assert(sizeof(mapBase58) / sizeof(mapBase58[0]) == 256, "mapBase58.size() should be 256");
-   while (*psz && !isspace(*psz)) {
-      int carry = mapBase58[(uint8_t)*psz];
-      if (carry == -1)
-         return false;
-      int i = 0;
-      for (vector<unsigned char>::reverse_iterator it = b256.rbegin();
-           (carry != 0 || i < length) && (it != b256.rend()); ++it, ++i) {
-         carry += 58 * (*it);
-         *it = carry % 256;
-         carry /= 256;
+   str.remove_prefix(zeroes);
+
+   // Little endian 32 bit limbs, up to 5 digits are folded in per pass since 58^5 < 2^32. Only 64 bit arithmetic is
+   // used, variable 128 bit shifts need __ashlti3 which is unimplemented in vert.
+   constexpr size_t limb_count = (BASE58_KEY_MAX_BYTES + 3) / 4;
+   uint32_t         limbs[limb_count];
+   size_t           used = 0;
+   while (!str.empty()) {
+      const size_t chunk      = str.size() < 5 ? str.size() : 5;
+      uint64_t     multiplier = 1;
+      uint64_t     carry      = 0;
+      for (size_t i = 0; i < chunk; i++) {
+         const int8_t digit = mapBase58[(uint8_t)str[i]];
+         if (digit == -1)
+            return 0;
+         carry       = carry * 58 + digit;
+         multiplier *= 58;
+      }
+      str.remove_prefix(chunk);
+
+      for (size_t i = 0; i < used; i++) {
+         carry    += uint64_t(limbs[i]) * multiplier;
+         limbs[i]  = uint32_t(carry);
+         carry   >>= 32;
+      }
+      while (carry != 0) {
+         if (used == limb_count)
+            return 0;
+         limbs[used++] = uint32_t(carry);
+         carry       >>= 32;
       }
-      assert(carry == 0);
-      length = i;
-      psz++;
    }
-   while (isspace(*psz))
-      psz++;
-   if (*psz != 0)
-      return false;
-   vector<unsigned char>::iterator it = b256.begin() + (size - length);
-   while (it != b256.end() && *it == 0)
-      it++;
-   vch.reserve(zeroes + (b256.end() - it));
-   vch.assign(zeroes, 0x00);
-   while (it != b256.end())
-      vch.push_back(*(it++));
-   return true;
-}
 
-bool decode_base58(const string& str, vector<unsigned char>& vch)
-{
-   int estimated_size = str.length() * 733 / 1000 + 1;
-   vch.reserve(estimated_size);
-   return DecodeBase58(str.c_str(), vch);
+   size_t significant = used * 4;
+   while (significant > 0 && ((limbs[(significant - 1) / 4] >> (((significant - 1) % 4) * 8)) & 0xff) == 0)
+      significant--;
+   if (zeroes + significant > out.size())
+      return 0;
+
+   memset(out.data(), 0, zeroes);
+   for (size_t i = 0; i < significant; i++) {
+      const size_t byte = significant - 1 - i;
+      out[zeroes + i]   = uint8_t(limbs[byte / 4] >> ((byte % 4) * 8));
+   }
+   return zeroes + significant;
 }
 
 // C intrinsic, not eosio::ripemd160: checksum160's uint128 words need __ashlti3, unimplemented in vert
-static void verifyKeyChecksum(const vector<unsigned char>& vch, std::string_view suffix)
+static void verifyKeyChecksum(const base58_key_buffer& vch, const size_t size, std::string_view suffix)
 {
-   vector<char> buf(vch.begin(), vch.end() - 4);
-   buf.insert(buf.end(), suffix.begin(), suffix.end());
+   char         buf[BASE58_KEY_MAX_BYTES + 2];
+   const size_t payload = size - 4;
+   memcpy(buf, vch.data(), payload);
+   memcpy(buf + payload, suffix.data(), suffix.size());
    capi_checksum160 digest;
-   ::ripemd160(buf.data(), buf.size(), &digest);
-   check(memcmp(digest.hash, vch.data() + vch.size() - 4, 4) == 0, "Invalid public key checksum");
+   ::ripemd160(buf, payload + suffix.size(), &digest);
+   check(memcmp(digest.hash, vch.data() + payload, 4) == 0, "Invalid public key checksum");
 }
 
-eosio::public_key stringToLegacyPublicKey(string public_key_str)
+eosio::public_key stringToLegacyPublicKey(std::string_view public_key_str)
 {
-   string pubkey_prefix("EOS");
-   auto   result = mismatch(pubkey_prefix.begin(), pubkey_prefix.end(), public_key_str.begin());
-   check(result.first == pubkey_prefix.end(), "Public key should be prefix with EOS");
-   auto base58substr = public_key_str.substr(pubkey_prefix.length());
+   check(public_key_str.substr(0, 3) == "EOS", "Public key should be prefix with EOS");
 
-   vector<unsigned char> vch;
-   check(decode_base58(base58substr, vch), "Decode pubkey failed");
-   check(vch.size() == 37, "Invalid public key length");
-   verifyKeyChecksum(vch, "");
+   base58_key_buffer vch;
+   const size_t      size = decode_base58(public_key_str.substr(3), vch);
+   check(size != 0, "Decode pubkey failed");
+   check(size == 37, "Invalid public key length");
+   verifyKeyChecksum(vch, size, "");
 
    array<char, 33> pubkey_data;
    copy_n(vch.begin(), 33, pubkey_data.begin());
@@ -82,7 +95,7 @@ eosio::public_key stringToLegacyPublicKey(string public_key_str)
    return eosio::public_key(in_place_index<0>, pubkey_data);
 }
 
-eosio::public_key stringToPublicKey(string public_key_str)
+eosio::public_key stringToPublicKey(std::string_view public_key_str)
 {
    size_t first = public_key_str.find('_');
    check(first != string::npos, "Invalid public key format");
@@ -90,15 +103,16 @@ eosio::public_key stringToPublicKey(string public_key_str)
    size_t second = public_key_str.find('_', first + 1);
    check(second != string::npos, "Invalid public key format");
 
-   string_view prefix(public_key_str.data(), first);
-   string_view type(public_key_str.data() + first + 1, second - first - 1);
-   string_view key(public_key_str.data() + second + 1, public_key_str.size() - second - 1);
+   std::string_view prefix = public_key_str.substr(0, first);
+   std::string_view type   = public_key_str.substr(first + 1, second - first - 1);
+   std::string_view key    = public_key_str.substr(second + 1);
 
    check(prefix == "PUB", "Public key should be prefix with PUB");
 
-   vector<unsigned char> vch;
-   check(decode_base58(string(key), vch), "Decode pubkey failed");
-   check(vch.size() >= 37, "Invalid public key length");
+   base58_key_buffer vch;
+   const size_t      size = decode_base58(key, vch);
+   check(size != 0, "Decode pubkey failed");
+   check(size >= 37, "Invalid public key length");
 
    array<char, 33> pubkey_data;
    copy_n(vch.begin(), 33, pubkey_data.begin());
@@ -108,23 +122,64 @@ eosio::public_key stringToPublicKey(string public_key_str)
          static_cast<eosio::webauthn_public_key::user_presence_t>(vch[33]);
 
       uint8_t rpidLength = vch[34];
-      check(vch.size() == 39u + rpidLength, "Invalid public key length");
-      verifyKeyChecksum(vch, "WA");
+      check(size == 39u + rpidLength, "Invalid public key length");
+      verifyKeyChecksum(vch, size, "WA");
 
       string rpid(vch.begin() + 35, vch.begin() + 35 + rpidLength);
 
       return eosio::public_key(in_place_index<2>, eosio::webauthn_public_key{pubkey_data, user_presence, rpid});
    } else if (type == "R1") {
-      check(vch.size() == 37, "Invalid public key length");
-      verifyKeyChecksum(vch, "R1");
+      check(size == 37, "Invalid public key length");
+      verifyKeyChecksum(vch, size, "R1");
       return eosio::public_key(in_place_index<1>, pubkey_data);
    } else if (type == "K1") {
-      check(vch.size() == 37, "Invalid public key length");
-      verifyKeyChecksum(vch, "K1");
+      check(size == 37, "Invalid public key length");
+      verifyKeyChecksum(vch, size, "K1");
       return eosio::public_key(in_place_index<0>, pubkey_data);
    }
    check(false, "Unsupported key type");
    __builtin_unreachable();
 }
 
+static int8_t hexValue(char c)
+{
+   if (c >= '0' && c <= '9')
+      return c - '0';
+   if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+   if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+   return -1;
+}
+
+bool isHexPublicKey(std::string_view public_key_str)
+{
+   const auto prefix = public_key_str.substr(0, 3);
+   return prefix == "K1:" || prefix == "R1:" || public_key_str.size() == 66;
+}
+
+eosio::public_key hexToPublicKey(std::string_view public_key_str)
+{
+   const bool r1 = public_key_str.substr(0, 3) == "R1:";
+   if (r1 || public_key_str.substr(0, 3) == "K1:") {
+      public_key_str.remove_prefix(3);
+   }
+   check(public_key_str.size() == 66, "Invalid public key length");
+
+   array<char, 33> pubkey_data;
+   for (size_t i = 0; i < pubkey_data.size(); i++) {
+      const int8_t high = hexValue(public_key_str[i * 2]);
+      const int8_t low  = hexValue(public_key_str[i * 2 + 1]);
+      check(high != -1 && low != -1, "Invalid hex public key");
+      pubkey_data[i] = char((high << 4) | low);
+   }
+   // Without a checksum, at least require the prefix of a compressed point
+   check(pubkey_data[0] == 0x02 || pubkey_data[0] == 0x03, "Invalid compressed public key");
+
+   if (r1) {
+      return eosio::public_key(in_place_index<1>, pubkey_data);
+   }
+   return eosio::public_key(in_place_index<0>, pubkey_data);
+}
+
 } // namespace antelope
@@ -3,6 +3,9 @@
 
 #include <eosio.system/eosio.system.hpp>
 
+#include <array>
+#include <string_view>
+
 namespace antelope {
 
 // Copied from https://github.com/bitcoin/bitcoin
@@ -20,9 +23,17 @@ const int8_t mapBase58[256] = {
    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
 };
 
-bool              DecodeBase58(const char* psz, std::vector<unsigned char>& vch);
-bool              decode_base58(const std::string& str, std::vector<unsigned char>& vch);
-eosio::public_key stringToLegacyPublicKey(std::string public_key_str);
-eosio::public_key stringToPublicKey(std::string str);
+// Largest decoded key payload: 33 byte point, WA user presence and rpid length, up to 255 bytes of rpid and checksum
+static constexpr size_t BASE58_KEY_MAX_BYTES = 33 + 2 + 255 + 4;
+using base58_key_buffer                      = std::array<unsigned char, BASE58_KEY_MAX_BYTES>;
+
+// Returns the number of bytes decoded into out, or 0 if the input is not base58 or does not fit
+size_t            decode_base58(std::string_view str, base58_key_buffer& out);
+eosio::public_key stringToLegacyPublicKey(std::string_view public_key_str);
+eosio::public_key stringToPublicKey(std::string_view public_key_str);
+
+// Raw 33 byte compressed keys as 66 hex characters, optionally prefixed with K1: or R1: (defaults to K1)
+bool              isHexPublicKey(std::string_view public_key_str);
+eosio::public_key hexToPublicKey(std::string_view public_key_str);
 
 } // namespace antelope
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "ram.hpp"
 
+#include <limits>
+
 namespace antelope {
 
 using eosio::asset;
@@ -100,4 +102,84 @@ asset ram_proceeds_minus_fee(uint32_t bytes, symbol core_symbol)
    return cost - fee;
 }
 
-} // namespace antelope
\ No newline at end of file
+namespace fixed {
+
+int64_t get_bancor_input(int64_t out_reserve, int64_t inp_reserve, int64_t out)
+{
+   check(out < out_reserve, "output exceeds the reserve");
+
+   const int128_t inp = int128_t(inp_reserve) * out / (out_reserve - out);
+   check(inp <= std::numeric_limits<int64_t>::max(), "input overflow");
+
+   return inp < 0 ? 0 : int64_t(inp);
+}
+
+int64_t get_bancor_output(int64_t inp_reserve, int64_t out_reserve, int64_t inp)
+{
+   const int128_t out = int128_t(inp) * out_reserve / (int128_t(inp_reserve) + inp);
+
+   return out < 0 ? 0 : int64_t(out);
+}
+
+int64_t bytes_cost_with_fee(const asset quantity)
+{
+   return ram_market(quantity.symbol).bytes_for(quantity);
+}
+
+asset ram_cost(uint32_t bytes, symbol core_symbol)
+{
+   return ram_market(core_symbol).cost(bytes);
+}
+
+asset ram_cost_with_fee(uint32_t bytes, symbol core_symbol)
+{
+   return ram_market(core_symbol).cost_with_fee(bytes);
+}
+
+asset ram_proceeds_minus_fee(uint32_t bytes, symbol core_symbol)
+{
+   return ram_market(core_symbol).proceeds_minus_fee(bytes);
+}
+
+} // namespace fixed
+
+ram_market::ram_market(symbol core_symbol, name system_account)
+   : _core_symbol(core_symbol)
+{
+   rammarket   _rammarket(system_account, system_account.value);
+   const auto& market = _rammarket.get(system_contract::ramcore_symbol.raw(), "RAM market not found");
+   _ram_reserve       = market.base.balance.amount;
+   _core_reserve      = market.quote.balance.amount;
+}
+
+asset ram_market::cost(uint32_t bytes, uint64_t bought_bytes) const
+{
+   const int64_t before = fixed::get_bancor_input(_ram_reserve, _core_reserve, bought_bytes);
+   const int64_t after  = fixed::get_bancor_input(_ram_reserve, _core_reserve, bought_bytes + bytes);
+   return asset{after - before, _core_symbol};
+}
+
+asset ram_market::cost_with_fee(uint32_t bytes, uint64_t bought_bytes) const
+{
+   const asset cost = this->cost(bytes, bought_bytes);
+   return cost + get_fee(cost);
+}
+
+asset ram_market::proceeds(uint32_t bytes) const
+{
+   return asset{fixed::get_bancor_output(_ram_reserve, _core_reserve, bytes), _core_symbol};
+}
+
+asset ram_market::proceeds_minus_fee(uint32_t bytes) const
+{
+   const asset proceeds = this->proceeds(bytes);
+   return proceeds - get_fee(proceeds);
+}
+
+int64_t ram_market::bytes_for(const asset quantity) const
+{
+   const asset quantity_after_fee = quantity - get_fee(quantity);
+   return fixed::get_bancor_output(_core_reserve, _ram_reserve, quantity_after_fee.amount);
+}
+
+} // namespace antelope
@@ -13,4 +13,40 @@ asset   ram_proceeds_minus_fee(uint32_t bytes, symbol core_symbol);
 asset   get_fee(const asset quantity);
 int64_t bytes_cost_with_fee(const asset quantity);
 
+// Snapshot of the RAMCORE market reserves. Reserves are read once on construction so any number of quotes within an
+// action are priced against the same market state, using the integer Bancor math.
+class ram_market
+{
+public:
+   explicit ram_market(symbol core_symbol, name system_account = "eosio"_n);
+
+   // bought_bytes prices the purchase as if that many bytes were already bought from this snapshot
+   asset   cost(uint32_t bytes, uint64_t bought_bytes = 0) const;
+   asset   cost_with_fee(uint32_t bytes, uint64_t bought_bytes = 0) const;
+   asset   proceeds(uint32_t bytes) const;
+   asset   proceeds_minus_fee(uint32_t bytes) const;
+   int64_t bytes_for(const asset quantity) const; // bytes bought with quantity after the fee
+
+   int64_t ram_reserve() const { return _ram_reserve; }
+   int64_t core_reserve() const { return _core_reserve; }
+
+private:
+   symbol  _core_symbol;
+   int64_t _ram_reserve  = 0;
+   int64_t _core_reserve = 0;
+};
+
+// Integer implementations of the Bancor RAM math above. Reserve products are computed exactly in 128 bits instead of
+// through softfloat doubles, the double versions are kept to cross-check against.
+namespace fixed {
+
+int64_t get_bancor_input(int64_t out_reserve, int64_t inp_reserve, int64_t out);
+int64_t get_bancor_output(int64_t inp_reserve, int64_t out_reserve, int64_t inp);
+asset   ram_cost(uint32_t bytes, symbol core_symbol);
+asset   ram_cost_with_fee(uint32_t bytes, symbol core_symbol);
+asset   ram_proceeds_minus_fee(uint32_t bytes, symbol core_symbol);
+int64_t bytes_cost_with_fee(const asset quantity);
+
+} // namespace fixed
+
 } // namespace antelope
\ No newline at end of file
@@ -1,6 +1,6 @@
 import {beforeEach, describe, expect, test} from 'bun:test'
 
-import {apiContract, contracts, resetContracts} from '../helpers'
+import {alice, apiContract, bob, contracts, resetContracts, systemtokenContract} from '../helpers'
 import {Asset, Name} from '@wharfkit/antelope'
 
 describe(`contract: ${apiContract}`, () => {
@@ -63,4 +63,183 @@ describe(`contract: ${apiContract}`, () => {
             })
         })
     })
+
+    describe('action: powerupcost', () => {
+        describe('error', () => {
+            test('rejects fractions out of range', async () => {
+                await expect(
+                    contracts.api.actions.powerupcost(['1000000000000001', 0]).send()
+                ).rejects.toThrow('cpu_frac must be between 0 and 10^15')
+                await expect(contracts.api.actions.powerupcost([0, -1]).send()).rejects.toThrow(
+                    'net_frac must be between 0 and 10^15'
+                )
+            })
+            test('requires an initialized powerup market', async () => {
+                await expect(
+                    contracts.api.actions.powerupcost(['10000000000', '10000000000']).send()
+                ).rejects.toThrow("powerup hasn't been initialized")
+            })
+        })
+    })
+
+    describe('action: powerupfor', () => {
+        describe('error', () => {
+            test('requires the system token symbol', async () => {
+                await expect(
+                    contracts.api.actions.powerupfor(['1.0000 FOO']).send()
+                ).rejects.toThrow('max_payment must use the system token symbol')
+            })
+        })
+    })
+
+    describe('action: producers', () => {
+        describe('success', () => {
+            test('returns an empty page without producers', async () => {
+                const traces = await contracts.api.actions.producers([null, 30, true]).send()
+                expect(traces[0].returnValue.producers).toHaveLength(0)
+                expect(traces[0].returnValue.next).toBeFalsy()
+            })
+        })
+        describe('error', () => {
+            test('rejects a limit outside the page bounds', async () => {
+                await expect(
+                    contracts.api.actions.producers([null, 0, true]).send()
+                ).rejects.toThrow('limit must be between 1 and 1000')
+                await expect(
+                    contracts.api.actions.producers([null, 1001, true]).send()
+                ).rejects.toThrow('limit must be between 1 and 1000')
+            })
+            test('rejects an unknown cursor', async () => {
+                await expect(
+                    contracts.api.actions.producers(['unknown', 30, true]).send()
+                ).rejects.toThrow('cursor producer not found')
+            })
+        })
+    })
+
+    describe('action: namebids', () => {
+        describe('success', () => {
+            test('returns an empty page without bids', async () => {
+                const traces = await contracts.api.actions.namebids([null, 30]).send()
+                expect(traces[0].returnValue.bids).toHaveLength(0)
+                expect(traces[0].returnValue.next).toBeFalsy()
+            })
+        })
+        describe('error', () => {
+            test('rejects an unknown cursor', async () => {
+                await expect(
+                    contracts.api.actions.namebids(['unknown', 30]).send()
+                ).rejects.toThrow('cursor name bid not found')
+            })
+        })
+    })
+
+    describe('action: resources', () => {
+        describe('success', () => {
+            test('includes the RAM given at creation for accounts without resources', async () => {
+                const traces = await contracts.api.actions.resources([[bob, alice, bob]]).send()
+                const results = traces[0].returnValue
+                expect(results.map((r) => String(r.account))).toEqual([alice, bob])
+                expect(results.map((r) => Number(r.ram_quota))).toEqual([1400, 1400])
+                expect(results[0].powerups).toHaveLength(0)
+            })
+        })
+    })
+
+    describe('action: rexloans', () => {
+        describe('success', () => {
+            test('returns no loans when REX is not initialized', async () => {
+                const traces = await contracts.api.actions.rexloans(['cpu', alice, null, 30]).send()
+                expect(traces[0].returnValue.loans).toHaveLength(0)
+            })
+        })
+        describe('error', () => {
+            test('rejects an unknown resource', async () => {
+                await expect(
+                    contracts.api.actions.rexloans(['ram', alice, null, 30]).send()
+                ).rejects.toThrow('resource must be either cpu or net')
+            })
+        })
+    })
+
+    describe('action: distribs', () => {
+        describe('success', () => {
+            test('loads multiple distributions with additional locked holders', async () => {
+                const traces = await contracts.api.actions
+                    .distribs([
+                        [
+                            {
+                                token: {contract: systemtokenContract, symbol: '4,A'},
+                                locked: [systemtokenContract],
+                            },
+                            {
+                                token: {contract: systemtokenContract, symbol: '4,A'},
+                                locked: [alice, systemtokenContract, alice],
+                            },
+                            {
+                                token: {contract: systemtokenContract, symbol: '4,B'},
+                                locked: [],
+                            },
+                        ],
+                    ])
+                    .send()
+                const [base, withAlice, b] = traces[0].returnValue
+                expect(String(base.distribution.locked)).toBe('999998000.0000 A')
+                expect(String(base.distribution.circulating)).toBe('2000.0000 A')
+
+                // alice is listed twice but her 1000.0000 A balance is only locked once
+                expect(String(withAlice.distribution.supply)).toBe('1000000000.0000 A')
+                expect(String(withAlice.distribution.locked)).toBe('999999000.0000 A')
+                expect(String(withAlice.distribution.circulating)).toBe('1000.0000 A')
+
+                expect(String(b.distribution.locked)).toBe('0.0000 B')
+                expect(String(b.distribution.circulating)).toBe('1000000000.0000 B')
+            })
+        })
+    })
+
+    describe('action: availables', () => {
+        describe('success', () => {
+            test('checks names in sorted order without duplicates', async () => {
+                const traces = await contracts.api.actions
+                    .availables([[bob, 'unknownacct', alice, bob]])
+                    .send()
+                const results = traces[0].returnValue
+                expect(results).toHaveLength(3)
+                expect(results.map((r) => String(r.account))).toEqual([alice, bob, 'unknownacct'])
+                expect(results.map((r) => r.available)).toEqual([false, false, true])
+            })
+        })
+    })
+
+    describe('action: balmatrix', () => {
+        describe('success', () => {
+            test('skips accounts without any balance rows', async () => {
+                const traces = await contracts.api.actions
+                    .balmatrix([
+                        ['unknownacct', systemtokenContract],
+                        [
+                            {contract: systemtokenContract, symbol: '4,A'},
+                            {contract: systemtokenContract, symbol: '4,B'},
+                        ],
+                    ])
+                    .send()
+                const {tokens, rows, amounts} = traces[0].returnValue
+                expect(tokens).toHaveLength(2)
+                expect(rows.map(Number)).toEqual([0b10])
+                expect(amounts).toHaveLength(2)
+            })
+        })
+    })
+
+    describe('action: network', () => {
+        describe('success', () => {
+            test('only includes the extended global state when requested', async () => {
+                const without = await contracts.api.actions.network([]).send()
+                expect(without[0].returnValue.globals).toBeFalsy()
+                const withGlobals = await contracts.api.actions.network([true]).send()
+                expect(withGlobals[0].returnValue.globals).toBeTruthy()
+            })
+        })
+    })
 })
@@ -0,0 +1,156 @@
+import {beforeEach, describe, expect, test} from 'bun:test'
+import {Asset, Name} from '@wharfkit/antelope'
+
+import {alice, contracts, createContract, resetContracts, validMemo} from './setup'
+
+function getDeposit(partner: string): Asset | undefined {
+    const row = contracts.create.tables.deposits().getTableRow(Name.from(partner).value.value)
+    return row ? Asset.from(row.balance) : undefined
+}
+
+describe('contract: create - Deposits', () => {
+    beforeEach(async () => {
+        await resetContracts()
+    })
+
+    describe('deposit memo', () => {
+        test('credits the sender with each deposit', async () => {
+            await contracts.token.actions
+                .transfer([alice, createContract, '10.0000 A', 'deposit'])
+                .send(alice)
+            await contracts.token.actions
+                .transfer([alice, createContract, '2.5000 A', 'deposit'])
+                .send(alice)
+            expect(String(getDeposit(alice))).toBe('12.5000 A')
+        })
+
+        test('rejects a first deposit below the cost of one creation', async () => {
+            await expect(
+                contracts.token.actions
+                    .transfer([alice, createContract, '0.0001 A', 'deposit'])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: A first deposit of at least')
+            expect(getDeposit(alice)).toBeUndefined()
+        })
+
+        test('accepts small top-ups once a deposit exists', async () => {
+            await contracts.token.actions
+                .transfer([alice, createContract, '10.0000 A', 'deposit'])
+                .send(alice)
+            await contracts.token.actions
+                .transfer([alice, createContract, '0.0001 A', 'deposit'])
+                .send(alice)
+            expect(String(getDeposit(alice))).toBe('10.0001 A')
+        })
+    })
+
+    describe('action: withdraw', () => {
+        test('returns part of a deposit and removes an emptied deposit', async () => {
+            await contracts.token.actions
+                .transfer([alice, createContract, '10.0000 A', 'deposit'])
+                .send(alice)
+            await contracts.create.actions.withdraw([alice, '4.0000 A']).send(alice)
+            expect(String(getDeposit(alice))).toBe('6.0000 A')
+            await contracts.create.actions.withdraw([alice, '6.0000 A']).send(alice)
+            expect(getDeposit(alice)).toBeUndefined()
+        })
+
+        test('rejects a partial withdrawal that leaves less than one creation', async () => {
+            await contracts.token.actions
+                .transfer([alice, createContract, '10.0000 A', 'deposit'])
+                .send(alice)
+            await expect(
+                contracts.create.actions.withdraw([alice, '9.9999 A']).send(alice)
+            ).rejects.toThrow('eosio_assert: Withdraw the full deposit or leave at least')
+        })
+
+        test('rejects withdrawing more than the deposit', async () => {
+            await contracts.token.actions
+                .transfer([alice, createContract, '1.0000 A', 'deposit'])
+                .send(alice)
+            await expect(
+                contracts.create.actions.withdraw([alice, '2.0000 A']).send(alice)
+            ).rejects.toThrow('eosio_assert: Insufficient deposit')
+        })
+
+        test('requires partner authority', async () => {
+            await expect(
+                contracts.create.actions.withdraw([alice, '1.0000 A']).send(createContract)
+            ).rejects.toThrow('missing required authority alice')
+        })
+    })
+
+    describe('action: createacct', () => {
+        const k1Key = 'PUB_K1_6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5BoDq63'
+
+        test('rejects an existing account', async () => {
+            await expect(
+                contracts.create.actions.createacct([alice, alice, k1Key]).send(alice)
+            ).rejects.toThrow('eosio_assert: Account already exists')
+        })
+
+        test('requires partner authority', async () => {
+            await expect(
+                contracts.create.actions
+                    .createacct([alice, 'newuser1aaaa', k1Key])
+                    .send(createContract)
+            ).rejects.toThrow('missing required authority alice')
+        })
+    })
+
+    describe('action: createauths', () => {
+        const k1Key = 'PUB_K1_6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5BoDq63'
+        const keyAuthority = {
+            threshold: 1,
+            keys: [{key: k1Key, weight: 1}],
+            accounts: [],
+            waits: [],
+        }
+
+        test('rejects an authority whose threshold cannot be met', async () => {
+            const owner = {
+                threshold: 2,
+                keys: [{key: k1Key, weight: 1}],
+                accounts: [{permission: {actor: alice, permission: 'active'}, weight: 0}],
+                waits: [],
+            }
+            await expect(
+                contracts.create.actions
+                    .createauths([alice, 'newuser1aaaa', owner, keyAuthority])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: Authority threshold cannot be met')
+        })
+
+        test('rejects a zero threshold', async () => {
+            const active = {...keyAuthority, threshold: 0}
+            await expect(
+                contracts.create.actions
+                    .createauths([alice, 'newuser1aaaa', keyAuthority, active])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: Authority threshold must be positive')
+        })
+    })
+
+    describe('action: estimatecost', () => {
+        test('requires owner and active together', async () => {
+            const owner = {
+                threshold: 1,
+                keys: [],
+                accounts: [{permission: {actor: alice, permission: 'active'}, weight: 1}],
+                waits: [],
+            }
+            await expect(
+                contracts.create.actions.estimatecost([owner]).send()
+            ).rejects.toThrow('eosio_assert: owner and active must be provided together')
+        })
+
+        test('never quotes less than a memo creation with a WebAuthn key is charged', async () => {
+            const waKey = validMemo.slice(validMemo.indexOf('-') + 1)
+            const quote = await contracts.create.actions.estimatecost([]).send()
+            const wa = await contracts.create.actions.estimate([0, waKey, 1]).send()
+            expect(Asset.from(quote[0].returnValue).units.toNumber()).toBeGreaterThanOrEqual(
+                Asset.from(wa[0].returnValue.cost).units.toNumber()
+            )
+        })
+    })
+})
@@ -0,0 +1,69 @@
+import {beforeEach, describe, expect, test} from 'bun:test'
+
+import {contracts, resetContracts, validMemo} from './setup'
+
+async function checkRamMath(ramReserve: string, eosReserve: string, count: number) {
+    const traces = await contracts.create.actions
+        .rammathcheck([ramReserve, eosReserve, count])
+        .send()
+    return traces[0].returnValue
+}
+
+describe('contract: create - RAM math', () => {
+    beforeEach(async () => {
+        await resetContracts()
+    })
+
+    describe('fixed point Bancor math', () => {
+        test('matches the double version exactly for small reserves', async () => {
+            const result = await checkRamMath('1000000', '10000', 1000)
+            expect(Number(result.checked)).toBe(3000)
+            expect(Number(result.mismatched)).toBe(0)
+        })
+
+        test('stays within one unit of the double version for mainnet sized reserves', async () => {
+            const result = await checkRamMath('400000000000', '40000000000', 5000)
+            expect(Number(result.checked)).toBe(15000)
+            expect(Number(result.max_difference)).toBeLessThanOrEqual(1)
+        })
+
+        test('stays within one unit of the double version when products exceed 2^53', async () => {
+            const result = await checkRamMath('4000000000000000000', '900000000000000000', 2000)
+            expect(Number(result.max_difference)).toBeLessThanOrEqual(1)
+        })
+    })
+
+    describe('action: estimate', () => {
+        test('rejects counts outside the estimate bounds', async () => {
+            await expect(contracts.create.actions.estimate([0, 'K1', 0]).send()).rejects.toThrow(
+                'eosio_assert: count must be between 1 and 1000'
+            )
+            await expect(contracts.create.actions.estimate([0, 'K1', 1001]).send()).rejects.toThrow(
+                'eosio_assert: count must be between 1 and 1000'
+            )
+        })
+
+        test('sizes WebAuthn keys from a sample key', async () => {
+            const waKey = validMemo.slice(validMemo.indexOf('-') + 1)
+            const k1 = await contracts.create.actions.estimate([0, 'K1', 1]).send()
+            const wa = await contracts.create.actions.estimate([0, waKey, 1]).send()
+            expect(Number(wa[0].returnValue.bytes)).toBeGreaterThan(
+                Number(k1[0].returnValue.bytes)
+            )
+        })
+
+        test('requires a sample key for WebAuthn estimates', async () => {
+            await expect(contracts.create.actions.estimate([0, 'WA', 1]).send()).rejects.toThrow(
+                'eosio_assert: WebAuthn estimates require a sample PUB_WA_ key'
+            )
+        })
+    })
+
+    describe('error', () => {
+        test('rejects counts that would drain the RAM reserve', async () => {
+            await expect(checkRamMath('1000', '1000', 1000)).rejects.toThrow(
+                'eosio_assert: count must be less than the RAM reserve'
+            )
+        })
+    })
+})
@@ -30,6 +30,7 @@ export const contracts = {
         './shared/include/eosio.token/eosio.token',
         true
     ),
+    system: blockchain.createContract('eosio', './contracts/mocksystem/build/mocksystem', true),
 }
 
 async function setupToken(key: string, issuer: string, symbol: string) {
@@ -51,4 +52,6 @@ export async function resetContracts() {
     await contracts.legacytoken.actions
         .transfer([legacyTokenContract, systemTokenContract, '100.0000 EOS', ''])
         .send(legacyTokenContract)
+
+    await contracts.system.actions.setrammarket(['400000000000', '40000000.0000 A']).send()
 }
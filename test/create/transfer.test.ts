@@ -174,6 +174,91 @@ describe('contract: create - Transfer Handling', () => {
                 contracts.create.actions.parsememo([`newuser1-${extended}`]).send()
             ).rejects.toThrow('eosio_assert: Invalid public key length')
         })
+
+        test('accepts raw hex K1 and R1 keys', async () => {
+            const k1Hex = PublicKey.from(k1Key).data.hexString
+            const r1Hex = PublicKey.from(r1Key).data.hexString
+            expect(await parseKey(k1Hex)).toBe(k1Key)
+            expect(await parseKey(`K1:${k1Hex}`)).toBe(k1Key)
+            expect(await parseKey(`R1:${r1Hex}`)).toBe(r1Key)
+        })
+
+        test('rejects malformed raw hex keys', async () => {
+            const k1Hex = PublicKey.from(k1Key).data.hexString
+            await expect(
+                contracts.create.actions.parsememo([`newuser1-${k1Hex.slice(0, -1)}g`]).send()
+            ).rejects.toThrow('eosio_assert: Invalid hex public key')
+            await expect(
+                contracts.create.actions.parsememo([`newuser1-04${k1Hex.slice(2)}`]).send()
+            ).rejects.toThrow('eosio_assert: Invalid compressed public key')
+            await expect(
+                contracts.create.actions.parsememo([`newuser1-K1:${k1Hex.slice(2)}`]).send()
+            ).rejects.toThrow('eosio_assert: Invalid public key length')
+        })
+
+        test('rejects keys that are not base58 or exceed the largest key payload', async () => {
+            const invalid = legacyKey.slice(0, -1) + '0'
+            await expect(
+                contracts.create.actions.parsememo([`newuser1-${invalid}`]).send()
+            ).rejects.toThrow('eosio_assert: Decode pubkey failed')
+            const oversized = `PUB_K1_${'z'.repeat(420)}`
+            await expect(
+                contracts.create.actions.parsememo([`newuser1-${oversized}`]).send()
+            ).rejects.toThrow('eosio_assert: Decode pubkey failed')
+        })
+    })
+
+    describe('batch memo', () => {
+        const k1Key = 'PUB_K1_6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5BoDq63'
+
+        test('rejects a batch containing the same account twice', async () => {
+            const memo = `newuser1aaaa-${k1Key},newuser1bbbb-${k1Key},newuser1aaaa-${k1Key}`
+            await expect(
+                contracts.token.actions
+                    .transfer([alice, createContract, '1.0000 A', memo])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: Duplicate account in memo')
+        })
+
+        test('rejects a batch with more than 25 accounts', async () => {
+            const memo = Array.from(
+                {length: 26},
+                (_, i) => `newuser${String.fromCharCode(97 + i)}aaaa-${k1Key}`
+            ).join(',')
+            await expect(
+                contracts.token.actions
+                    .transfer([alice, createContract, '1.0000 A', memo])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: Too many accounts in memo')
+        })
+
+        test('rejects a batch with an invalid entry', async () => {
+            const memo = `newuser1aaaa-${k1Key},invalidentry`
+            await expect(
+                contracts.token.actions
+                    .transfer([alice, createContract, '1.0000 A', memo])
+                    .send(alice)
+            ).rejects.toThrow('eosio_assert: Invalid memo format')
+        })
+    })
+
+    describe('receipt mode', () => {
+        test('defaults to inline logcreation receipts', async () => {
+            expect(contracts.create.tables.config().getTableRows()).toHaveLength(0)
+        })
+
+        test('enables the receipts table with contract authority', async () => {
+            await contracts.create.actions.setreceipts([true]).send(createContract)
+            const [config] = contracts.create.tables.config().getTableRows()
+            expect(config.receipt_table).toBeTrue()
+            expect(Number(config.next_receipt)).toBe(0)
+        })
+
+        test('requires contract authority', async () => {
+            await expect(contracts.create.actions.setreceipts([true]).send(alice)).rejects.toThrow(
+                `missing required authority ${createContract}`
+            )
+        })
     })
 
     describe('bypass memo', () => {
@@ -56,6 +56,26 @@ describe('contract: gift - giftacct', () => {
         ).rejects.toThrow('must be created by eosio::newaccount in the same transaction')
     })
 
+    test('finds the newaccount among unrelated actions in the transaction', async () => {
+        await sendActions(
+            packAction(
+                contracts.system,
+                'giftram',
+                {from: bob, to: alice, bytes: 10, memo: 'x'},
+                bob
+            ),
+            packAction(contracts.system, 'newaccount', {creator: alice, account: bob}, alice),
+            packAction(contracts.system, 'newaccount', {creator: alice, account: newuser}, alice),
+            packAction(
+                contracts.gift,
+                'giftacct',
+                {creator: alice, account: newuser, bytes: 4000, memo: ''},
+                alice
+            )
+        )
+        expect(Number(getGiftedRam(newuser).ram_bytes)).toBe(4000)
+    })
+
     test('requires the creator authority', async () => {
         await expect(
             contracts.gift.actions.giftacct([alice, newuser, 4000, '']).send(bob)
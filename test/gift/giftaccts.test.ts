@@ -0,0 +1,74 @@
+import {beforeEach, describe, expect, test} from 'bun:test'
+import {Name} from '@wharfkit/antelope'
+
+import {
+    alice,
+    bob,
+    contracts,
+    getCreator,
+    newuser,
+    packAction,
+    resetContracts,
+    sendActions,
+} from './setup'
+
+function getGiftedRam(account: string) {
+    return contracts.system.tables
+        .giftedram(Name.from('eosio').value.value)
+        .getTableRow(Name.from(account).value.value)
+}
+
+function giftManyInTx(creator: string, created: string[], gifts: [string, number][], memo = '') {
+    return sendActions(
+        ...created.map((account) =>
+            packAction(contracts.system, 'newaccount', {creator, account}, creator)
+        ),
+        packAction(
+            contracts.gift,
+            'giftaccts',
+            {creator, gifts: gifts.map(([first, second]) => ({first, second})), memo},
+            creator
+        )
+    )
+}
+
+describe('contract: gift - giftaccts', () => {
+    beforeEach(async () => {
+        await resetContracts()
+        await contracts.gift.actions.addcreator([alice, 10000]).send()
+    })
+
+    test('gifts every account created in the transaction and charges the quota once', async () => {
+        await giftManyInTx(alice, [newuser, bob], [
+            [newuser, 3000],
+            [bob, 2000],
+        ])
+        expect(Number(getGiftedRam(newuser).ram_bytes)).toBe(3000)
+        expect(Number(getGiftedRam(bob).ram_bytes)).toBe(2000)
+        expect(Number(getCreator(alice).used_bytes)).toBe(5272)
+    })
+
+    test('rejects the batch when any account was not created in the transaction', async () => {
+        await expect(
+            giftManyInTx(alice, [newuser], [
+                [newuser, 3000],
+                [bob, 2000],
+            ])
+        ).rejects.toThrow('must be created by eosio::newaccount in the same transaction')
+        expect(getGiftedRam(newuser)).toBeUndefined()
+    })
+
+    test('rejects the batch when the total exceeds the quota', async () => {
+        await expect(
+            giftManyInTx(alice, [newuser, bob], [
+                [newuser, 5000],
+                [bob, 4729],
+            ])
+        ).rejects.toThrow('daily quota exceeded')
+        expect(Number(getCreator(alice).used_bytes)).toBe(0)
+    })
+
+    test('rejects an empty batch', async () => {
+        await expect(giftManyInTx(alice, [], [])).rejects.toThrow('no gifts provided')
+    })
+})
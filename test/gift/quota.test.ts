@@ -0,0 +1,158 @@
+import {beforeEach, describe, expect, test} from 'bun:test'
+import {Name} from '@wharfkit/antelope'
+
+import {
+    alice,
+    bob,
+    contracts,
+    getCreator,
+    giftContract,
+    newuser,
+    packAction,
+    resetContracts,
+    sendActions,
+} from './setup'
+
+function getShard(creator: string, shard: number) {
+    return contracts.gift.tables.shards(Name.from(creator).value.value).getTableRow(BigInt(shard))
+}
+
+function getConfig() {
+    return contracts.gift.tables.config(Name.from(giftContract).value.value).getTableRows()[0]
+}
+
+function giftFromShard(creator: string, account: string, bytes: number, shard: number) {
+    return sendActions(
+        packAction(contracts.system, 'newaccount', {creator, account}, creator),
+        packAction(contracts.gift, 'giftacct', {creator, account, bytes, memo: '', shard}, creator)
+    )
+}
+
+describe('contract: gift - quota shards and budget', () => {
+    beforeEach(async () => {
+        await resetContracts()
+        await contracts.gift.actions.addcreator([alice, 10000]).send()
+    })
+
+    describe('action: setshard', () => {
+        test('charges a shard without writing the creator row', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await giftFromShard(alice, newuser, 4000, 1)
+            expect(Number(getShard(alice, 1).used_bytes)).toBe(4136)
+            expect(Number(getCreator(alice).used_bytes)).toBe(0)
+        })
+
+        test('enforces the shard quota on its own', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await expect(giftFromShard(alice, newuser, 4865, 1)).rejects.toThrow(
+                'daily quota exceeded'
+            )
+        })
+
+        test('updates the quota of an existing shard', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await contracts.gift.actions.setshard([alice, 1, 8000]).send()
+            expect(Number(getShard(alice, 1).daily_quota_bytes)).toBe(8000)
+        })
+
+        test('rejects an unknown shard', async () => {
+            await expect(giftFromShard(alice, newuser, 4000, 2)).rejects.toThrow('shard not found')
+        })
+
+        test('requires a registered creator', async () => {
+            await expect(contracts.gift.actions.setshard([bob, 1, 5000]).send()).rejects.toThrow(
+                'creator not registered'
+            )
+        })
+
+        test('records tracked usage in a shard row instead of the creator row', async () => {
+            await contracts.gift.actions.trackusage([alice, true]).send()
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await giftFromShard(alice, newuser, 4000, 1)
+
+            const [creatorUsage] = contracts.gift.tables.usage().getTableRows()
+            expect(creatorUsage.days.map(Number).every((bytes) => bytes === 0)).toBeTrue()
+            const shardUsage = contracts.gift.tables
+                .shardusage(Name.from(alice).value.value)
+                .getTableRows()
+            expect(shardUsage).toHaveLength(1)
+
+            const traces = await contracts.gift.actions.getquota([[alice]]).send()
+            const [quota] = traces[0].returnValue
+            expect(Number(quota.daily_usage[29])).toBe(4136)
+
+            await contracts.gift.actions.rmshard([alice, 1]).send()
+            expect(
+                contracts.gift.tables.shardusage(Name.from(alice).value.value).getTableRows()
+            ).toHaveLength(0)
+        })
+
+        test('is listed by getquota', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            const traces = await contracts.gift.actions.getquota([[alice]]).send()
+            const [quota] = traces[0].returnValue
+            expect(quota.shards).toHaveLength(1)
+            expect(Number(quota.shards[0].daily_quota_bytes)).toBe(5000)
+        })
+    })
+
+    describe('action: rmshard', () => {
+        test('removes a shard and rmcreator removes the remaining ones', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await contracts.gift.actions.setshard([alice, 2, 5000]).send()
+            await contracts.gift.actions.rmshard([alice, 1]).send()
+            expect(getShard(alice, 1)).toBeUndefined()
+            await contracts.gift.actions.rmcreator([alice]).send()
+            expect(getShard(alice, 2)).toBeUndefined()
+        })
+    })
+
+    describe('action: setbudget', () => {
+        test('counts the quota assigned before the budget was set', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await contracts.gift.actions.setbudget([20000]).send()
+            expect(Number(getConfig().allocated_bytes)).toBe(15000)
+        })
+
+        test('rejects quota beyond the budget', async () => {
+            await contracts.gift.actions.setbudget([15000]).send()
+            await expect(contracts.gift.actions.addcreator([bob, 6000]).send()).rejects.toThrow(
+                'daily budget exceeded'
+            )
+            await expect(contracts.gift.actions.setshard([alice, 1, 6000]).send()).rejects.toThrow(
+                'daily budget exceeded'
+            )
+            await contracts.gift.actions.setquota([alice, 9000]).send()
+            await contracts.gift.actions.setshard([alice, 1, 6000]).send()
+            expect(Number(getConfig().allocated_bytes)).toBe(15000)
+        })
+
+        test('releases quota when creators and shards are removed', async () => {
+            await contracts.gift.actions.setshard([alice, 1, 5000]).send()
+            await contracts.gift.actions.setbudget([15000]).send()
+            await contracts.gift.actions.rmshard([alice, 1]).send()
+            expect(Number(getConfig().allocated_bytes)).toBe(10000)
+            await contracts.gift.actions.rmcreator([alice]).send()
+            expect(Number(getConfig().allocated_bytes)).toBe(0)
+        })
+
+        test('rejects a budget below the allocated quota', async () => {
+            await expect(contracts.gift.actions.setbudget([9999]).send()).rejects.toThrow(
+                'budget is below the allocated quota'
+            )
+        })
+
+        test('removes the budget when set to zero', async () => {
+            await contracts.gift.actions.setbudget([10000]).send()
+            await contracts.gift.actions.setbudget([0]).send()
+            expect(getConfig()).toBeUndefined()
+            await contracts.gift.actions.addcreator([bob, 6000]).send()
+        })
+
+        test('requires the contract authority', async () => {
+            await expect(contracts.gift.actions.setbudget([10000]).send(alice)).rejects.toThrow(
+                'missing required authority'
+            )
+        })
+    })
+})
@@ -0,0 +1,88 @@
+import {beforeEach, describe, expect, test} from 'bun:test'
+
+import {advanceTime} from '../helpers'
+import {alice, bob, contracts, giftInTx, newuser, resetContracts} from './setup'
+
+async function getQuota(...creators: string[]) {
+    const traces = await contracts.gift.actions.getquota([creators]).send()
+    return traces[0].returnValue
+}
+
+describe('contract: gift - usage', () => {
+    beforeEach(async () => {
+        await resetContracts()
+        await contracts.gift.actions.addcreator([alice, 10000]).send()
+    })
+
+    describe('action: getquota', () => {
+        test('reports remaining bytes for registered and unregistered creators', async () => {
+            await giftInTx(alice, newuser, 4000)
+            const [a, b] = await getQuota(alice, bob)
+            expect(a.registered).toBeTrue()
+            expect(Number(a.used_bytes)).toBe(4136)
+            expect(Number(a.remaining_bytes)).toBe(5864)
+            expect(Number(a.giftable_bytes)).toBe(5728)
+            expect(a.daily_usage).toHaveLength(0)
+            expect(b.registered).toBeFalse()
+            expect(Number(b.remaining_bytes)).toBe(0)
+            expect(Number(b.giftable_bytes)).toBe(0)
+        })
+
+        test('reports giftable bytes that a single gift can use exactly', async () => {
+            await giftInTx(alice, newuser, 4000)
+            const [before] = await getQuota(alice)
+            await giftInTx(alice, bob, Number(before.giftable_bytes))
+            const [after] = await getQuota(alice)
+            expect(Number(after.remaining_bytes)).toBe(0)
+            expect(Number(after.giftable_bytes)).toBe(0)
+        })
+
+        test('applies the window rollover without a gift', async () => {
+            await giftInTx(alice, newuser, 9864)
+            advanceTime(86400)
+            const [quota] = await getQuota(alice)
+            expect(Number(quota.used_bytes)).toBe(0)
+            expect(Number(quota.remaining_bytes)).toBe(10000)
+            expect(Number(quota.giftable_bytes)).toBe(9864)
+        })
+    })
+
+    describe('action: trackusage', () => {
+        test('records charged bytes per day once enabled', async () => {
+            await contracts.gift.actions.trackusage([alice, true]).send()
+            await giftInTx(alice, newuser, 4000)
+            let [quota] = await getQuota(alice)
+            expect(quota.daily_usage).toHaveLength(30)
+            expect(Number(quota.daily_usage[29])).toBe(4136)
+
+            advanceTime(86400)
+            await giftInTx(alice, newuser, 1000)
+            ;[quota] = await getQuota(alice)
+            expect(Number(quota.daily_usage[28])).toBe(4136)
+            expect(Number(quota.daily_usage[29])).toBe(1136)
+
+            advanceTime(86400 * 30)
+            ;[quota] = await getQuota(alice)
+            expect(quota.daily_usage.map(Number).every((bytes) => bytes === 0)).toBeTrue()
+        })
+
+        test('stops tracking and removes the history when disabled', async () => {
+            await contracts.gift.actions.trackusage([alice, true]).send()
+            await contracts.gift.actions.trackusage([alice, false]).send()
+            const [quota] = await getQuota(alice)
+            expect(quota.daily_usage).toHaveLength(0)
+        })
+
+        test('requires a registered creator', async () => {
+            await expect(contracts.gift.actions.trackusage([bob, true]).send()).rejects.toThrow(
+                'creator not registered'
+            )
+        })
+
+        test('requires contract authority', async () => {
+            await expect(
+                contracts.gift.actions.trackusage([alice, true]).send(alice)
+            ).rejects.toThrow('missing required authority')
+        })
+    })
+})
@@ -105,6 +105,83 @@ describe(`contract: ${tokensContract}`, () => {
         })
     })
 
+    describe('action: transfers', () => {
+        describe('success', () => {
+            test('transfers to many accounts across symbols', async () => {
+                await contracts.tokens.actions.create([alice, '1000.0000 FOO']).send()
+                await contracts.tokens.actions.issue([alice, '1000.0000 FOO', '']).send(alice)
+                await contracts.tokens.actions.create([alice, '1000.00 BAR']).send()
+                await contracts.tokens.actions.issue([alice, '1000.00 BAR', '']).send(alice)
+
+                await contracts.tokens.actions
+                    .transfers([
+                        alice,
+                        [
+                            {first: bob, second: '10.0000 FOO'},
+                            {first: tokensContract, second: '5.00 BAR'},
+                            {first: bob, second: '2.5000 FOO'},
+                        ],
+                        'payroll',
+                    ])
+                    .send(alice)
+
+                const bobBalance = await contracts.tokens.tables
+                    .accounts(Name.from(bob).value.value)
+                    .getTableRows()
+                expect(bobBalance[0].balance).toBe('12.5000 FOO')
+
+                const aliceBalances = await contracts.tokens.tables
+                    .accounts(Name.from(alice).value.value)
+                    .getTableRows()
+                expect(aliceBalances.map((row) => row.balance).sort()).toEqual([
+                    '987.5000 FOO',
+                    '995.00 BAR',
+                ])
+            })
+        })
+        describe('error', () => {
+            test('rejects an overdrawn total', async () => {
+                await contracts.tokens.actions.create([alice, '1000.0000 FOO']).send()
+                await contracts.tokens.actions.issue([alice, '10.0000 FOO', '']).send(alice)
+                await expect(
+                    contracts.tokens.actions
+                        .transfers([
+                            alice,
+                            [
+                                {first: bob, second: '6.0000 FOO'},
+                                {first: bob, second: '6.0000 FOO'},
+                            ],
+                            '',
+                        ])
+                        .send(alice)
+                ).rejects.toThrow('eosio_assert: overdrawn balance')
+            })
+            test('rejects a precision mismatch', async () => {
+                await contracts.tokens.actions.create([alice, '1000.0000 FOO']).send()
+                await contracts.tokens.actions.issue([alice, '10.0000 FOO', '']).send(alice)
+                await expect(
+                    contracts.tokens.actions
+                        .transfers([
+                            alice,
+                            [
+                                {first: bob, second: '1.0000 FOO'},
+                                {first: bob, second: '1.00 FOO'},
+                            ],
+                            '',
+                        ])
+                        .send(alice)
+                ).rejects.toThrow('eosio_assert: symbol precision mismatch')
+            })
+            test('requires authority of sender', async () => {
+                await expect(
+                    contracts.tokens.actions
+                        .transfers([alice, [{first: bob, second: '1.0000 FOO'}], ''])
+                        .send(bob)
+                ).rejects.toThrow('missing required authority alice')
+            })
+        })
+    })
+
     describe('action: setconfig', () => {
         describe('success', () => {
             test('set registry contract', async () => {
@@ -293,8 +370,64 @@ describe(`contract: ${tokensContract}`, () => {
                 expect(bobBalance).toHaveLength(1)
                 expect(bobBalance[0].balance).toBe('10.0000 FOO')
             })
+            test('distributes the token directly without inline transfers', async () => {
+                await contracts.token.actions
+                    .transfer([alice, registryContract, '50.0000 A', ''])
+                    .send(alice)
+                await contracts.registry.actions.regtoken([alice, 'FOO', 4, '1.0000 A']).send(alice)
+                await contracts.registry.actions.setcontract(['FOO', tokensContract]).send(alice)
+                await contracts.tokens.actions.setsupply(['FOO', '100.0000 FOO']).send(alice)
+                await contracts.tokens.actions.open([alice, '4,FOO', alice]).send(alice)
+                await contracts.tokens.actions.open([bob, '4,FOO', alice]).send(alice)
+
+                const traces = await contracts.tokens.actions
+                    .distribute([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '60.0000 FOO'},
+                            {receiver: bob, quantity: '30.0000 FOO'},
+                            {receiver: bob, quantity: '10.0000 FOO'},
+                        ],
+                        true,
+                    ])
+                    .send(alice)
+                const actions = traces.map((trace) => String(trace.action))
+                expect(actions).not.toContain('transfer')
+                expect(actions.filter((action) => action === 'logdistrib')).toHaveLength(1)
+
+                const contractBalance = await contracts.tokens.tables
+                    .accounts(Name.from(tokensContract).value.value)
+                    .getTableRows()
+                expect(contractBalance).toHaveLength(0)
+
+                const bobBalance = await contracts.tokens.tables
+                    .accounts(Name.from(bob).value.value)
+                    .getTableRows()
+                expect(bobBalance[0].balance).toBe('40.0000 FOO')
+            })
         })
         describe('error', () => {
+            test('direct distribution requires opened balances', async () => {
+                await contracts.token.actions
+                    .transfer([alice, registryContract, '50.0000 A', ''])
+                    .send(alice)
+                await contracts.registry.actions.regtoken([alice, 'FOO', 4, '1.0000 A']).send(alice)
+                await contracts.registry.actions.setcontract(['FOO', tokensContract]).send(alice)
+                await contracts.tokens.actions.setsupply(['FOO', '100.0000 FOO']).send(alice)
+                await contracts.tokens.actions.open([alice, '4,FOO', alice]).send(alice)
+                await expect(
+                    contracts.tokens.actions
+                        .distribute([
+                            'FOO',
+                            [
+                                {receiver: alice, quantity: '90.0000 FOO'},
+                                {receiver: bob, quantity: '10.0000 FOO'},
+                            ],
+                            true,
+                        ])
+                        .send(alice)
+                ).rejects.toThrow('balance must be opened first for: bob')
+            })
             test('must provide at least one allocation', async () => {
                 await contracts.token.actions
                     .transfer([alice, registryContract, '50.0000 A', ''])
@@ -537,6 +670,184 @@ describe(`contract: ${tokensContract}`, () => {
         })
     })
 
+    describe('action: stagealloc', () => {
+        beforeEach(async () => {
+            await contracts.token.actions
+                .transfer([alice, registryContract, '50.0000 A', ''])
+                .send(alice)
+            await contracts.registry.actions.regtoken([alice, 'FOO', 4, '1.0000 A']).send(alice)
+            await contracts.registry.actions.setcontract(['FOO', tokensContract]).send(alice)
+            await contracts.tokens.actions.setsupply(['FOO', '100.0000 FOO']).send(alice)
+            await contracts.tokens.actions.open([alice, '4,FOO', alice]).send(alice)
+            await contracts.tokens.actions.open([bob, '4,FOO', alice]).send(alice)
+        })
+
+        function getBalances(account: string) {
+            return contracts.tokens.tables.accounts(Name.from(account).value.value).getTableRows()
+        }
+
+        describe('success', () => {
+            test('stages chunks and pays them out in bounded batches', async () => {
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '50.0000 FOO'},
+                            {receiver: bob, quantity: '20.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions
+                    .stagealloc(['FOO', [{receiver: bob, quantity: '30.0000 FOO'}]])
+                    .send(alice)
+                expect(contracts.tokens.tables.allocations().getTableRows()).toHaveLength(3)
+
+                await contracts.tokens.actions.execalloc(['FOO', 2]).send(bob)
+                expect(getBalances(alice)[0].balance).toBe('50.0000 FOO')
+                expect(getBalances(bob)[0].balance).toBe('20.0000 FOO')
+                expect(getBalances(tokensContract)[0].balance).toBe('30.0000 FOO')
+
+                await contracts.tokens.actions.execalloc(['FOO', 2]).send(bob)
+                expect(getBalances(bob)[0].balance).toBe('50.0000 FOO')
+                expect(getBalances(tokensContract)).toHaveLength(0)
+                expect(contracts.tokens.tables.allocations().getTableRows()).toHaveLength(0)
+                expect(contracts.tokens.tables.staged().getTableRows()).toHaveLength(0)
+            })
+            test('pays a receiver that closed its balance after staging', async () => {
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '60.0000 FOO'},
+                            {receiver: bob, quantity: '40.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions.execalloc(['FOO', 1]).send(alice)
+                await contracts.tokens.actions.close([bob, '4,FOO']).send(bob)
+                expect(getBalances(bob)).toHaveLength(0)
+
+                await contracts.tokens.actions.execalloc(['FOO', 1]).send(alice)
+                expect(getBalances(bob)[0].balance).toBe('40.0000 FOO')
+                expect(getBalances(tokensContract)).toHaveLength(0)
+                expect(contracts.tokens.tables.staged().getTableRows()).toHaveLength(0)
+            })
+            test('keeps tokens transferred to the contract during the payout', async () => {
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '60.0000 FOO'},
+                            {receiver: bob, quantity: '40.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions.execalloc(['FOO', 1]).send(bob)
+                await contracts.tokens.actions
+                    .transfer([alice, tokensContract, '5.0000 FOO', ''])
+                    .send(alice)
+                await contracts.tokens.actions.execalloc(['FOO', 1]).send(bob)
+
+                expect(getBalances(tokensContract)[0].balance).toBe('5.0000 FOO')
+                expect(getBalances(alice)[0].balance).toBe('55.0000 FOO')
+                expect(getBalances(bob)[0].balance).toBe('40.0000 FOO')
+                expect(contracts.tokens.tables.staged().getTableRows()).toHaveLength(0)
+            })
+            test('clears a mistaken staging so it can be staged again', async () => {
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '50.0000 FOO'},
+                            {receiver: alice, quantity: '20.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions.clearalloc(['FOO', 1]).send(alice)
+                expect(contracts.tokens.tables.allocations().getTableRows()).toHaveLength(1)
+                expect(contracts.tokens.tables.staged().getTableRows()[0].quantity).toBe(
+                    '20.0000 FOO'
+                )
+                await contracts.tokens.actions.clearalloc(['FOO', 10]).send(alice)
+                expect(contracts.tokens.tables.allocations().getTableRows()).toHaveLength(0)
+                expect(contracts.tokens.tables.staged().getTableRows()).toHaveLength(0)
+
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '50.0000 FOO'},
+                            {receiver: bob, quantity: '50.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions.execalloc(['FOO', 10]).send(bob)
+                expect(getBalances(bob)[0].balance).toBe('50.0000 FOO')
+                expect(getBalances(tokensContract)).toHaveLength(0)
+            })
+        })
+        describe('error', () => {
+            test('cannot clear allocations once the payout has started', async () => {
+                await contracts.tokens.actions
+                    .stagealloc([
+                        'FOO',
+                        [
+                            {receiver: alice, quantity: '50.0000 FOO'},
+                            {receiver: bob, quantity: '50.0000 FOO'},
+                        ],
+                    ])
+                    .send(alice)
+                await contracts.tokens.actions.execalloc(['FOO', 1]).send(bob)
+                await expect(
+                    contracts.tokens.actions.clearalloc(['FOO', 10]).send(alice)
+                ).rejects.toThrow('eosio_assert: staged allocations have already been paid out')
+            })
+            test('clearing requires authority of the token creator or issuer', async () => {
+                await contracts.tokens.actions
+                    .stagealloc(['FOO', [{receiver: alice, quantity: '50.0000 FOO'}]])
+                    .send(alice)
+                await expect(
+                    contracts.tokens.actions.clearalloc(['FOO', 10]).send(bob)
+                ).rejects.toThrow('missing required authority alice')
+            })
+            test('staged allocations cannot exceed the supply', async () => {
+                await contracts.tokens.actions
+                    .stagealloc(['FOO', [{receiver: alice, quantity: '90.0000 FOO'}]])
+                    .send(alice)
+                await expect(
+                    contracts.tokens.actions
+                        .stagealloc(['FOO', [{receiver: bob, quantity: '10.0001 FOO'}]])
+                        .send(alice)
+                ).rejects.toThrow('eosio_assert: staged allocations exceed the supply')
+            })
+            test('cannot pay out before the supply is fully staged', async () => {
+                await contracts.tokens.actions
+                    .stagealloc(['FOO', [{receiver: alice, quantity: '90.0000 FOO'}]])
+                    .send(alice)
+                await expect(
+                    contracts.tokens.actions.execalloc(['FOO', 10]).send(bob)
+                ).rejects.toThrow('eosio_assert: staged allocations must match the supply')
+            })
+            test('distribute is blocked while allocations are staged', async () => {
+                await contracts.tokens.actions
+                    .stagealloc(['FOO', [{receiver: alice, quantity: '90.0000 FOO'}]])
+                    .send(alice)
+                await expect(
+                    contracts.tokens.actions
+                        .distribute(['FOO', [{receiver: alice, quantity: '100.0000 FOO'}]])
+                        .send(alice)
+                ).rejects.toThrow('eosio_assert: allocations are staged for this token')
+            })
+            test('requires authority of creator from registry contract', async () => {
+                await expect(
+                    contracts.tokens.actions
+                        .stagealloc(['FOO', [{receiver: bob, quantity: '10.0000 FOO'}]])
+                        .send(bob)
+                ).rejects.toThrow('missing required authority alice')
+            })
+        })
+    })
+
     describe('standard errors', () => {
         describe('action: create', () => {
             test('require contract auth', async () => {